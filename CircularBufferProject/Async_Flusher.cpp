@@ -0,0 +1,128 @@
+#include<algorithm>
+#include<cerrno>
+#include<sys/uio.h>
+#include"Async_Flusher.h"
+
+
+AsyncFlusher::AsyncFlusher(int fd, size_type capacity, size_type batch_size, std::chrono::microseconds max_latency) {
+	if (capacity <= 0 || batch_size <= 0) {
+		CB_THROW(std::invalid_argument("Capacity and batch size must be positive"));
+	}
+	_buffers[0].set_capacity(capacity);
+	_buffers[1].set_capacity(capacity);
+	_live = 0;
+	_fd = fd;
+	_batch_size = std::min(batch_size, capacity);
+	_max_latency = max_latency;
+	_requested = 0;
+	_completed = 0;
+	_dropped = 0;
+	_written = 0;
+	_stop = false;
+	// Wake the flusher exactly when a buffer reaches a full batch, not on every push.
+	for (CircularBuffer& buffer : _buffers) {
+		buffer.set_watermarks(_batch_size, 0, [this]() { _wake.notify_one(); });
+	}
+	_thread = std::thread(&AsyncFlusher::run, this);
+}
+
+AsyncFlusher::~AsyncFlusher() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_one();
+	_thread.join();
+}
+
+void AsyncFlusher::push(const value_type& item) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	CircularBuffer& live = _buffers[_live];
+	if (live.full()) {
+		_dropped++;
+	}
+	live.push_back(item);
+}
+
+void AsyncFlusher::flush() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	std::uint64_t target = ++_requested;
+	_wake.notify_one();
+	_flushed.wait(lock, [&]() { return _completed >= target; });
+}
+
+void AsyncFlusher::run() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (;;) {
+		_wake.wait_for(lock, _max_latency, [&]() {
+			return _stop || _requested != _completed || _buffers[_live].size() >= _batch_size;
+		});
+		std::uint64_t target = _requested;
+		if (!_buffers[_live].empty()) {
+			// Detach the live buffer; producers continue in the empty spare.
+			CircularBuffer& batch = _buffers[_live];
+			_live = 1 - _live;
+			lock.unlock();
+			write_out(batch);
+			batch.try_clear();
+			lock.lock();
+		}
+		_completed = target;
+		_flushed.notify_all();
+		if (_stop && _buffers[_live].empty()) {
+			return;
+		}
+	}
+}
+
+void AsyncFlusher::write_out(const CircularBuffer& batch) {
+	SegmentPair<const value_type> parts = batch.segments();
+	iovec iov[2];
+	iov[0].iov_base = const_cast<value_type*>(parts.first.data);
+	iov[0].iov_len = parts.first.size * sizeof(value_type);
+	iov[1].iov_base = const_cast<value_type*>(parts.second.data);
+	iov[1].iov_len = parts.second.size * sizeof(value_type);
+	int count = parts.second.empty() ? 1 : 2;
+	iovec* next = iov;
+
+	while (count > 0) {
+		ssize_t n = ::writev(_fd, next, count);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_error) {
+				_error = std::error_code(errno, std::generic_category());
+			}
+			return;
+		}
+		// Skip what was written; a short write resumes inside a segment.
+		while (count > 0 && static_cast<std::size_t>(n) >= next->iov_len) {
+			n -= next->iov_len;
+			next++;
+			count--;
+		}
+		if (count > 0) {
+			next->iov_base = static_cast<char*>(next->iov_base) + n;
+			next->iov_len -= n;
+		}
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	_written += parts.size();
+}
+
+std::uint64_t AsyncFlusher::dropped() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _dropped;
+}
+
+std::uint64_t AsyncFlusher::written() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _written;
+}
+
+std::error_code AsyncFlusher::error() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _error;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include "Circular_Buffer.h"
+
+/**
+ * Drains records pushed by producers to a file descriptor on a background
+ * thread, double buffered. Producers append to the live CircularBuffer under
+ * a short mutex and never wait for I/O. The flusher swaps the live buffer
+ * with the empty spare, writes the detached segments with one writev() per
+ * batch without holding the lock, and only then clears the buffer for
+ * reuse. A batch is written once batch_size records are queued or
+ * max_latency has passed, whichever comes first. If the disk falls behind
+ * and the live buffer fills up, the oldest records are overwritten and
+ * counted in dropped(). POSIX only.
+ */
+class AsyncFlusher {
+	CircularBuffer _buffers[2];		// Live and spare buffer, swapped by index
+	int _live;						// Index of the buffer producers append to
+	int _fd;						// Destination descriptor, not owned
+	size_type _batch_size;			// Queued records that trigger a write
+	std::chrono::microseconds _max_latency;	// Longest time a record waits for a write
+
+	std::mutex _mutex;					// Guards everything below and the live buffer
+	std::condition_variable _wake;		// Wakes the flusher thread
+	std::condition_variable _flushed;	// Wakes threads blocked in flush()
+	std::uint64_t _requested;			// Number of flush() calls
+	std::uint64_t _completed;			// Requests covered by finished writes
+	std::uint64_t _dropped;				// Records overwritten before being written
+	std::uint64_t _written;				// Records written
+	std::error_code _error;				// First write error, if any
+	bool _stop;							// Set by the destructor
+	std::thread _thread;				// The flusher thread
+
+	void run();
+	void write_out(const CircularBuffer& batch);
+
+public:
+	/**
+     * Constructor that starts the flusher thread.
+     * @param fd Descriptor to write to; it must outlive the flusher.
+     * @param capacity Records each of the two buffers can hold.
+     * @param batch_size Queued records that trigger a write, clamped to capacity.
+     * @param max_latency Longest time a record waits before it is written.
+     * @throws std::invalid_argument if capacity or batch_size is not positive.
+     */
+	AsyncFlusher(int fd, size_type capacity, size_type batch_size, std::chrono::microseconds max_latency);
+
+	/**
+     * Writes the remaining records and stops the flusher thread.
+     */
+	~AsyncFlusher();
+
+	AsyncFlusher(const AsyncFlusher&) = delete;
+	AsyncFlusher& operator=(const AsyncFlusher&) = delete;
+
+	/**
+     * Queue a record. Never blocks on I/O; if the live buffer is full,
+     * the oldest queued record is overwritten and counted as dropped.
+     */
+	void push(const value_type& item);
+
+	/**
+     * Block until every record pushed before the call has been written.
+     */
+	void flush();
+
+	/**
+     * Get the number of records lost to overwriting and the number written.
+     */
+	std::uint64_t dropped();
+	std::uint64_t written();
+
+	/**
+     * Get the first error reported by writev(), empty if none.
+     * Records of a batch that failed are discarded.
+     */
+	std::error_code error();
+};
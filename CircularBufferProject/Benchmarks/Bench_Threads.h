@@ -0,0 +1,19 @@
+#pragma once
+#include <thread>
+#include <vector>
+
+// Числа потоков для замеров: степени двойки меньше числа ядер, затем само
+// число ядер один раз. Если число ядер неизвестно (hardware_concurrency()
+// возвращает 0), замер выполняется на одном потоке.
+inline std::vector<int> bench_thread_counts() {
+	int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+	if (max_threads < 1) {
+		max_threads = 1;
+	}
+	std::vector<int> counts;
+	for (int threads = 1; threads < max_threads; threads *= 2) {
+		counts.push_back(threads);
+	}
+	counts.push_back(max_threads);
+	return counts;
+}
@@ -0,0 +1,160 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Circular_Buffer.h"
+#include "../Task_Pool.h"
+#include "../Work_Stealing_Deque.h"
+#include "Bench_Threads.h"
+
+// Fork-join по полному двоичному дереву: узел порождает двух потомков,
+// лист выполняет немного вычислений. Сравниваются общая очередь
+// CircularBuffer под мьютексом, деки WorkStealingDeque с кражей и TaskPool.
+// Запуск: ./forkjoin_bench [глубина] [работа листа], сборка с -DCMAKE_BUILD_TYPE=Release.
+
+template <typename Function>
+static double measure_ms(Function f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static long long leaf(int node, int work) {
+	unsigned x = static_cast<unsigned>(node);
+	for (int i = 0; i < work; i++) {
+		x = x * 1664525u + 1013904223u;
+	}
+	return x & 0xff;
+}
+
+static int depth_of(int node) {
+	return 31 - __builtin_clz(static_cast<unsigned>(node) + 1);
+}
+
+// Узлы нумеруются как в двоичной куче: потомки узла i - 2i + 1 и 2i + 2.
+static long long run_mutex_ring(int threads, int depth, int work) {
+	CircularBuffer queue(1 << 16);
+	std::mutex mutex;
+	std::atomic<long long> sum(0);
+	std::atomic<int> leaves_left(1 << depth);
+	queue.push_back(0);
+
+	auto worker = [&]() {
+		long long local = 0;
+		while (leaves_left.load(std::memory_order_relaxed) > 0) {
+			int node;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (queue.empty()) {
+					continue;
+				}
+				node = queue.back();
+				queue.pop_back();
+			}
+			if (depth_of(node) == depth) {
+				local += leaf(node, work);
+				leaves_left.fetch_sub(1, std::memory_order_relaxed);
+			} else {
+				std::lock_guard<std::mutex> lock(mutex);
+				queue.push_back(2 * node + 1);
+				queue.push_back(2 * node + 2);
+			}
+		}
+		sum += local;
+	};
+	std::vector<std::thread> pool;
+	for (int i = 0; i < threads; i++) {
+		pool.emplace_back(worker);
+	}
+	for (std::thread& t : pool) {
+		t.join();
+	}
+	return sum;
+}
+
+static long long run_stealing(int threads, int depth, int work) {
+	std::vector<std::unique_ptr<WorkStealingDeque<int>>> deques;
+	for (int i = 0; i < threads; i++) {
+		deques.emplace_back(new WorkStealingDeque<int>(64));
+	}
+	std::atomic<long long> sum(0);
+	std::atomic<int> leaves_left(1 << depth);
+	deques[0]->push(0);
+
+	auto worker = [&](int self) {
+		long long local = 0;
+		while (leaves_left.load(std::memory_order_relaxed) > 0) {
+			std::optional<int> node = deques[self]->pop();
+			for (int i = 1; !node && i < threads; i++) {
+				node = deques[(self + i) % threads]->steal();
+			}
+			if (!node) {
+				continue;
+			}
+			if (depth_of(*node) == depth) {
+				local += leaf(*node, work);
+				leaves_left.fetch_sub(1, std::memory_order_relaxed);
+			} else {
+				deques[self]->push(2 * *node + 1);
+				deques[self]->push(2 * *node + 2);
+			}
+		}
+		sum += local;
+	};
+	std::vector<std::thread> pool;
+	for (int i = 0; i < threads; i++) {
+		pool.emplace_back(worker, i);
+	}
+	for (std::thread& t : pool) {
+		t.join();
+	}
+	return sum;
+}
+
+static void visit(TaskPool& pool, std::atomic<long long>& sum, int node, int depth, int work) {
+	if (depth_of(node) == depth) {
+		sum.fetch_add(leaf(node, work), std::memory_order_relaxed);
+		return;
+	}
+	TaskGroup group(pool);
+	group.run([&pool, &sum, node, depth, work]() { visit(pool, sum, 2 * node + 1, depth, work); });
+	visit(pool, sum, 2 * node + 2, depth, work);
+	group.wait();
+}
+
+static long long run_task_pool(int threads, int depth, int work) {
+	TaskPool pool(threads);
+	std::atomic<long long> sum(0);
+	pool.submit([&]() { visit(pool, sum, 0, depth, work); });
+	pool.wait();
+	return sum;
+}
+
+int main(int argc, char** argv) {
+	int depth = argc > 1 ? std::atoi(argv[1]) : 18;
+	int work = argc > 2 ? std::atoi(argv[2]) : 200;
+	// Число листьев 1 << depth и номера узлов до 2^(depth + 1) - 2 должны помещаться в int.
+	if (depth < 0 || depth > 30) {
+		std::cerr << "depth must be from 0 to 30\n";
+		return 1;
+	}
+
+	std::cout << "leaves: " << (1 << depth) << ", leaf work: " << work << "\n";
+	std::cout << "threads\tmutex_ring_ms\tstealing_ms\ttask_pool_ms\n";
+	for (int threads : bench_thread_counts()) {
+		long long a = 0;
+		long long b = 0;
+		long long c = 0;
+		double mutex_ms = measure_ms([&]() { a = run_mutex_ring(threads, depth, work); });
+		double stealing_ms = measure_ms([&]() { b = run_stealing(threads, depth, work); });
+		double pool_ms = measure_ms([&]() { c = run_task_pool(threads, depth, work); });
+		std::cout << threads << "\t" << mutex_ms << "\t" << stealing_ms << "\t" << pool_ms
+		          << (a == b && b == c ? "" : "\t(checksum mismatch)") << "\n";
+	}
+	return 0;
+}
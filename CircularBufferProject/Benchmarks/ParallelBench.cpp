@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "../Circular_Buffer.h"
+#include "../Parallel_Algorithms.h"
+#include "Bench_Threads.h"
+
+// Масштабирование параллельных алгоритмов от 1 потока до всех ядер.
+// Запуск: ./parallel_bench [число элементов], сборка с -DCMAKE_BUILD_TYPE=Release.
+
+template <typename Function>
+static double measure_ms(Function f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static void fill(CircularBuffer& cb, int n) {
+	std::mt19937 gen(1);
+	if (!cb.empty()) {
+		cb.clear();
+	}
+	for (int i = 0; i < n + n / 3; i++) {
+		cb.push_back(static_cast<value_type>(gen() % 1000000)); // голова не в начале
+	}
+}
+
+int main(int argc, char** argv) {
+	int n = argc > 1 ? std::atoi(argv[1]) : 50000000;
+
+	CircularBuffer cb(n);
+	fill(cb, n);
+
+	std::cout << "elements: " << n << "\n";
+	std::cout << "threads\treduce_ms\ttransform_reduce_ms\tfor_each_ms\tsort_ms\n";
+	for (int threads : bench_thread_counts()) {
+		long long sum = 0;
+		double reduce_ms = measure_ms([&]() {
+			sum = parallel_reduce(cb, 0LL, std::plus<long long>(), threads);
+		});
+		double squares_ms = measure_ms([&]() {
+			parallel_transform_reduce(cb, 0.0, std::plus<double>(),
+				[](const value_type& v) { return static_cast<double>(v) * v; }, threads);
+		});
+		double for_each_ms = measure_ms([&]() {
+			parallel_for_each(cb, [](value_type& v) { v = v * 3 + 1; }, threads);
+		});
+		fill(cb, n);
+		double sort_ms = measure_ms([&]() {
+			parallel_sort(cb, std::less<value_type>(), threads);
+		});
+		fill(cb, n);
+
+		std::cout << threads << "\t" << reduce_ms << "\t" << squares_ms << "\t"
+		          << for_each_ms << "\t" << sort_ms << "\t(sum " << sum << ")\n";
+	}
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include<stdexcept>
+#include"Bip_Buffer.h"
+
+
+BipBuffer::BipBuffer(int capacity) {
+	if (capacity < 0) {
+		CB_THROW(std::invalid_argument("Capacity must be non-negative"));
+	}
+	buffer.resize(capacity);
+	clear();
+}
+
+Segment<byte_type> BipBuffer::reserve(int n) {
+	Segment<byte_type> region = { buffer.data(), 0 };
+	_r_size = 0;
+	if (n <= 0) {
+		return region;
+	}
+	if (_a_start == _a_end && !_b_active) {
+		_a_start = 0;
+		_a_end = 0;
+	}
+
+	if (_b_active) {
+		if (_a_start - _b_end < n) {
+			return region;
+		}
+		_r_start = _b_end;
+	} else if (capacity() - _a_end >= n) {
+		_r_start = _a_end;
+	} else if (_a_start >= n) {
+		_r_start = 0;
+	} else {
+		return region;
+	}
+	_r_size = n;
+	region.data = buffer.data() + _r_start;
+	region.size = n;
+	return region;
+}
+
+void BipBuffer::commit(int n) {
+	if (n < 0 || n > _r_size) {
+		CB_THROW(std::invalid_argument("Commit exceeds the reserved size"));
+	}
+	if (n > 0) {
+		if (_a_start == _a_end && !_b_active) {
+			_a_start = _r_start;
+			_a_end = _r_start + n;
+		} else if (!_b_active && _r_start == _a_end) {
+			_a_end += n;
+		} else {
+			_b_active = true;
+			_b_end = _r_start + n;
+		}
+	}
+	_r_size = 0;
+}
+
+Segment<const byte_type> BipBuffer::read() const {
+	Segment<const byte_type> region = { buffer.data() + _a_start, _a_end - _a_start };
+	return region;
+}
+
+void BipBuffer::release(int n) {
+	if (n < 0 || n > _a_end - _a_start) {
+		CB_THROW(std::out_of_range("Release exceeds the readable region"));
+	}
+	_a_start += n;
+	if (_a_start == _a_end) {
+		if (_b_active) {
+			_a_start = 0;
+			_a_end = _b_end;
+			_b_end = 0;
+			_b_active = false;
+		} else if (_r_size == 0) {
+			_a_start = 0;
+			_a_end = 0;
+		}
+	}
+}
+
+int BipBuffer::size() const {
+	return (_a_end - _a_start) + _b_end;
+}
+
+int BipBuffer::reserved() const {
+	return _r_size;
+}
+
+bool BipBuffer::empty() const {
+	return size() == 0;
+}
+
+int BipBuffer::capacity() const {
+	return static_cast<int>(buffer.size());
+}
+
+void BipBuffer::clear() {
+	_a_start = 0;
+	_a_end = 0;
+	_b_end = 0;
+	_b_active = false;
+	_r_start = 0;
+	_r_size = 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include "Circular_Buffer.h"
+
+typedef unsigned char byte_type;
+
+/**
+ * Byte ring in the bip-buffer layout: committed data lives in up to two
+ * regions, A and B, where B grows from the start of the storage once the
+ * space after A is too small. Every reservation and every read is a single
+ * contiguous region, so producers serialize records directly into the ring
+ * and consumers parse them in place. The gap left at the tail when writing
+ * switches to B is skipped and never returned by read().
+ */
+class BipBuffer {
+	std::vector<byte_type> buffer;	// Storage
+	int _a_start;					// Start of region A (oldest committed data)
+	int _a_end;						// End of region A
+	int _b_end;						// End of region B, which always starts at 0
+	bool _b_active;					// Whether new data goes to region B
+	int _r_start;					// Start of the outstanding reservation
+	int _r_size;					// Size of the outstanding reservation, 0 if none
+
+public:
+	/**
+     * Constructor to initialize a buffer with a specific capacity.
+     * @param capacity Size of the storage in bytes.
+     * @throws std::invalid_argument if the capacity is negative.
+     */
+	explicit BipBuffer(int capacity);
+
+	/**
+     * Reserve a contiguous writable region. Replaces any uncommitted reservation.
+     * @param n Number of bytes to reserve.
+     * @return The reserved region, or an empty segment if n contiguous bytes are not available.
+     */
+	Segment<byte_type> reserve(int n);
+
+	/**
+     * Make the first n bytes of the outstanding reservation readable.
+     * The rest of the reservation is dropped.
+     * @param n Number of bytes written into the reservation.
+     * @throws std::invalid_argument if n exceeds the reserved size.
+     */
+	void commit(int n);
+
+	/**
+     * Get the oldest contiguous region of committed data.
+     * @return The region, empty if nothing is committed.
+     */
+	Segment<const byte_type> read() const;
+
+	/**
+     * Mark the first n bytes returned by read() as consumed.
+     * @param n Number of bytes to release.
+     * @throws std::out_of_range if n exceeds the size of the region returned by read().
+     */
+	void release(int n);
+
+	/**
+     * Get the number of committed bytes across both regions.
+     */
+	int size() const;
+
+	/**
+     * Get the size of the outstanding reservation, 0 if there is none.
+     */
+	int reserved() const;
+
+	bool empty() const;
+	int capacity() const;
+
+	/**
+     * Drop all committed data and the outstanding reservation.
+     */
+	void clear();
+};
@@ -1,132 +1,378 @@
 #include<iostream>
 #include<algorithm>
+#include<new>
+#include<utility>
 #include"Circular_Buffer.h"
 
+#ifdef __linux__
+#include<sys/mman.h>
+#endif
+
+#ifdef CB_PROFILING
+#include"Latency_Histogram.h"
+#define CB_PROFILE(op) ProfileScope profile_scope(ProfiledOp::op)
+#else
+#define CB_PROFILE(op)
+#endif
+
+struct CircularBuffer::Watermarks {
+	size_type high;					// Size at which on_high fires
+	size_type low;					// Size at which on_low fires
+	std::function<void()> on_high;
+	std::function<void()> on_low;
+};
+
+CircularBuffer::SharedHeader* CircularBuffer::header() const {
+	return reinterpret_cast<SharedHeader*>(buffer) - 1;
+}
+
+value_type* CircularBuffer::allocate(size_type capacity) {
+	if (capacity <= inline_capacity) {
+		return _inline;
+	}
+	if (static_cast<std::size_t>(capacity) > (SIZE_MAX - sizeof(SharedHeader)) / sizeof(value_type)) {
+		CB_THROW(std::length_error("Capacity is too large"));
+	}
+	std::size_t bytes = sizeof(SharedHeader) + sizeof(value_type) * static_cast<std::size_t>(capacity);
+	void* raw = nullptr;
+	std::size_t mapped_bytes = 0;
+#ifdef __linux__
+	if (bytes >= CB_MMAP_THRESHOLD) {
+		// Pages are only backed once an element lands on them.
+		raw = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (raw == MAP_FAILED) {
+			CB_THROW(std::bad_alloc());
+		}
+		mapped_bytes = bytes;
+	}
+#endif
+	if (mapped_bytes == 0) {
+		raw = ::operator new(bytes);
+	}
+	SharedHeader* shared = new (raw) SharedHeader;
+	shared->refs.store(1, std::memory_order_relaxed);
+	shared->mapped_bytes = mapped_bytes;
+	return reinterpret_cast<value_type*>(shared + 1);
+}
+
+void CircularBuffer::release() {
+	if (buffer != _inline) {
+		SharedHeader* shared = header();
+		if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			std::size_t mapped_bytes = shared->mapped_bytes;
+			shared->~SharedHeader();
+			if (mapped_bytes == 0) {
+				::operator delete(shared);
+			} else {
+#ifdef __linux__
+				munmap(shared, mapped_bytes);
+#endif
+			}
+		}
+	}
+	buffer = _inline;
+	_unshareable = false;
+}
+
+void CircularBuffer::share(const CircularBuffer& cb) {
+	// A pinned source may still be written through a reference it handed
+	// out, so it gets a private copy instead of a shared one.
+	bool deep = !cb.is_inline() && cb._unshareable;
+	value_type* storage = deep ? allocate(cb._capacity) : cb.buffer;
+	if (deep) {
+		SegmentPair<const value_type> live = cb.segments();
+		value_type* out = std::copy(live.first.begin(), live.first.end(), storage);
+		std::copy(live.second.begin(), live.second.end(), out);
+	}
+	release();
+	if (cb.is_inline()) {
+		std::copy(cb._inline, cb._inline + cb._capacity, _inline);
+	} else {
+		buffer = storage;
+		if (!deep) {
+			header()->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	_capacity = cb._capacity;
+	_size = cb._size;
+	_idx_head = deep ? 0 : cb._idx_head;
+	_idx_end = deep ? (cb.full() ? 0 : cb._size) : cb._idx_end;
+	isfull = cb.isfull;
+	_seq_head = cb._seq_head;
+	_seq_next = cb._seq_next;
+}
+
+void CircularBuffer::detach() {
+	if (!is_shared()) {
+		return;
+	}
+	value_type* new_buffer = allocate(_capacity);
+	SegmentPair<const value_type> live = static_cast<const CircularBuffer*>(this)->segments();
+	value_type* out = std::copy(live.first.begin(), live.first.end(), new_buffer);
+	std::copy(live.second.begin(), live.second.end(), out);
+	release();
+	buffer = new_buffer;
+	_idx_head = 0;
+	_idx_end = full() ? 0 : _size;
+}
+
+void CircularBuffer::pin() {
+	detach();
+	_unshareable = !is_inline();
+}
 
 CircularBuffer::CircularBuffer() {
-	buffer = nullptr;
+	buffer = _inline;
 	_capacity = 0;
 	_size = 0;
 	_idx_head = 0;
 	_idx_end = 0;
 	isfull = false;
+	_unshareable = false;
+	_seq_head = 0;
+	_seq_next = 0;
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_relaxed);
 }
 CircularBuffer::~CircularBuffer() {
-	delete[] buffer;
+	release();
+	delete _watermarks;
 }
 CircularBuffer::CircularBuffer(const CircularBuffer & cb) {
-	buffer = new value_type[cb._capacity];
-	buffer = cb.buffer;
-	_capacity = cb._capacity;
-	_size = cb._size;
-	_idx_head = cb._idx_head;
-	_idx_end = cb._idx_end;
-	isfull = cb.isfull;
+	buffer = _inline;
+	_unshareable = false;
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_relaxed);
+	share(cb);
+}
 
-	std::copy(cb.buffer, cb.buffer + cb._size, buffer);
+CircularBuffer::CircularBuffer(CircularBuffer&& cb) noexcept {
+	buffer = _inline;
+	_capacity = 0;
+	_size = 0;
+	_idx_head = 0;
+	_idx_end = 0;
+	isfull = false;
+	_unshareable = false;
+	_seq_head = 0;
+	_seq_next = 0;
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_relaxed);
+	*this = std::move(cb);
 }
 
-CircularBuffer::CircularBuffer(int capacity) {
+CircularBuffer::CircularBuffer(size_type capacity) {
 	if (capacity < 0) {
-    	throw std::invalid_argument("Capacity must be non-negative");
+    	CB_THROW(std::invalid_argument("Capacity must be non-negative"));
 	}
 
-	buffer = new value_type[capacity];
+	buffer = allocate(capacity);
 	_capacity = capacity;
 	_size = 0;
 	_idx_head = 0;
 	_idx_end = 0;
 	isfull = false;
+	_unshareable = false;
+	_seq_head = 0;
+	_seq_next = 0;
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_relaxed);
 }
 
-CircularBuffer::CircularBuffer(int capacity, const value_type& elem) {
-	buffer = new value_type[capacity];
+CircularBuffer::CircularBuffer(size_type capacity, const value_type& elem) {
+	buffer = allocate(capacity);
 	_capacity = capacity;
 	_size = capacity;
 	_idx_head = 0;
-	_idx_end = _size % _capacity;
+	_idx_end = 0;
 
-	for(int i = 0; i < _capacity; i++) {
+	for(size_type i = 0; i < _capacity; i++) {
 		buffer[i] = elem;
 	}
 
 	isfull = true;
-
+	_unshareable = false;
+	_seq_head = 0;
+	_seq_next = static_cast<sequence_type>(capacity);
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_relaxed);
 }
 
-value_type& CircularBuffer::operator[](int i) {
+value_type& CircularBuffer::operator[](size_type i) {
+	pin();
 	return buffer[(_idx_head + i) % _capacity];
 }
-const value_type& CircularBuffer::operator[](int i) const {
+const value_type& CircularBuffer::operator[](size_type i) const {
 	return buffer[(_idx_head + i) % _capacity];
 }
 
-value_type& CircularBuffer::at(int i) {
+value_type& CircularBuffer::at(size_type i) {
 	if (i < 0 || i >= _size) {
-		throw std::out_of_range("Index out of range");
+		CB_THROW(std::out_of_range("Index out of range"));
 	}
-	return buffer[i];
+	return (*this)[i];
 }
-const value_type& CircularBuffer::at(int i) const {
+const value_type& CircularBuffer::at(size_type i) const {
 	if (i < 0 || i >= _size) {
-		throw std::out_of_range("Index out of range");
+		CB_THROW(std::out_of_range("Index out of range"));
 	}
-	return buffer[i];
+	return (*this)[i];
 }
 
 value_type& CircularBuffer::front() {
 	if(empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
+	pin();
 	return buffer[_idx_head];
 }
 
 const value_type& CircularBuffer::front() const {
 	if(empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
-	return _idx_head;
+	return buffer[_idx_head];
 }
 
 value_type& CircularBuffer::back() {
 	if (empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
-	
+	pin();
 	return buffer[(_idx_end - 1 + _capacity) % _capacity];
 }
 
 const value_type& CircularBuffer::back() const {
 	if (empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
 
 
 	return buffer[(_idx_end - 1 + _capacity) % _capacity];
 }
 
+std::optional<value_type> CircularBuffer::try_front() const noexcept {
+	if (empty()) {
+		return std::nullopt;
+	}
+	return buffer[_idx_head];
+}
+
+std::optional<value_type> CircularBuffer::try_back() const noexcept {
+	if (empty()) {
+		return std::nullopt;
+	}
+	return buffer[(_idx_end - 1 + _capacity) % _capacity];
+}
+
+std::optional<value_type> CircularBuffer::try_at(size_type i) const noexcept {
+	if (i < 0 || i >= _size) {
+		return std::nullopt;
+	}
+	return (*this)[i];
+}
+
+sequence_type CircularBuffer::first_seq() const {
+	return _seq_head;
+}
+
+sequence_type CircularBuffer::last_seq() const {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _seq_next - 1;
+}
+
+sequence_type CircularBuffer::next_seq() const {
+	return _seq_next;
+}
+
+value_type& CircularBuffer::at_seq(sequence_type seq) {
+	if (seq < _seq_head) {
+		CB_THROW(sequence_overwritten(seq, _seq_head));
+	}
+	if (seq >= next_seq()) {
+		CB_THROW(std::out_of_range("Sequence not pushed yet"));
+	}
+	return (*this)[static_cast<size_type>(seq - _seq_head)];
+}
+
+const value_type& CircularBuffer::at_seq(sequence_type seq) const {
+	if (seq < _seq_head) {
+		CB_THROW(sequence_overwritten(seq, _seq_head));
+	}
+	if (seq >= next_seq()) {
+		CB_THROW(std::out_of_range("Sequence not pushed yet"));
+	}
+	return (*this)[static_cast<size_type>(seq - _seq_head)];
+}
+
+SegmentPair<const value_type> CircularBuffer::read_from_seq(sequence_type seq) const {
+	if (seq < _seq_head) {
+		CB_THROW(sequence_overwritten(seq, _seq_head));
+	}
+	if (seq > next_seq()) {
+		CB_THROW(std::out_of_range("Sequence not pushed yet"));
+	}
+	size_type skip = static_cast<size_type>(seq - _seq_head);
+	SegmentPair<const value_type> result = segments();
+	if (skip < result.first.size) {
+		result.first.data += skip;
+		result.first.size -= skip;
+	} else {
+		skip -= result.first.size;
+		result.first.data = result.second.data + skip;
+		result.first.size = result.second.size - skip;
+		result.second.size = 0;
+	}
+	return result;
+}
+
 value_type* CircularBuffer::linearize() {
+	pin();
 	if (!is_linearized()) {
 		std::rotate(buffer, buffer + _idx_head, buffer + _capacity);
 		_idx_head = 0;
-		_idx_end = _size;
+		_idx_end = full() ? 0 : _size;
     }
 	return buffer;
 }
 
+SegmentPair<value_type> CircularBuffer::segments() {
+	pin();
+	size_type first_len = std::min(_size, _capacity - _idx_head);
+	SegmentPair<value_type> result;
+	result.first.data = buffer + _idx_head;
+	result.first.size = first_len;
+	result.second.data = buffer;
+	result.second.size = _size - first_len;
+	return result;
+}
+
+SegmentPair<const value_type> CircularBuffer::segments() const {
+	size_type first_len = std::min(_size, _capacity - _idx_head);
+	SegmentPair<const value_type> result;
+	result.first.data = buffer + _idx_head;
+	result.first.size = first_len;
+	result.second.data = buffer;
+	result.second.size = _size - first_len;
+	return result;
+}
+
 bool CircularBuffer::is_linearized() const {
-	return (_size == 0) || (_idx_head <= _idx_end);
+	return (_size == 0) || (_idx_head + _size <= _capacity);
 }
 
-void CircularBuffer::rotate(int new_begin) {
+void CircularBuffer::rotate(size_type new_begin) {
 	if (new_begin < 0 || new_begin >= _size) {
-		throw std::out_of_range("Invalid rotation index");
+		CB_THROW(std::out_of_range("Invalid rotation index"));
 	}
 	_idx_head = (_idx_head + new_begin) % _capacity;
 	_idx_end = (_idx_end + new_begin) % _capacity;
+	renumber();
 }
 
-int CircularBuffer::size() const {
+size_type CircularBuffer::size() const {
 	return _size;
 }
 
@@ -138,150 +384,357 @@ bool CircularBuffer::full() const {
 	return _size == _capacity;
 }
 
-int CircularBuffer::reserve() const {
+size_type CircularBuffer::reserve() const {
 	return _capacity - _size;
 }
 
-int CircularBuffer::capacity() const {
+size_type CircularBuffer::capacity() const {
 	return _capacity;
 }
 
-void CircularBuffer::set_capacity(int new_capacity) {
+bool CircularBuffer::is_inline() const {
+	return buffer == _inline;
+}
+
+bool CircularBuffer::is_shared() const {
+	return !is_inline() && header()->refs.load(std::memory_order_acquire) > 1;
+}
+
+void CircularBuffer::set_capacity(size_type new_capacity) {
+	CB_PROFILE(SetCapacity);
 	if (new_capacity < _size) {
-		throw std::invalid_argument("New capacity is less than the current size");
+		CB_THROW(std::invalid_argument("New capacity is less than the current size"));
 	}
-	value_type* new_buffer = new value_type[new_capacity];
-	int current_idx = _idx_head;
-	for (int i = 0; i < _size; ++i) {
-		new_buffer[i] = buffer[current_idx];
-		current_idx = (current_idx + 1) % _capacity; 
+	if (is_inline() && new_capacity <= inline_capacity) {
+		linearize();
+	} else {
+		value_type* new_buffer = allocate(new_capacity);
+		size_type current_idx = _idx_head;
+		for (size_type i = 0; i < _size; ++i) {
+			new_buffer[i] = buffer[current_idx];
+			current_idx = (current_idx + 1) % _capacity; 
+		}
+		release();
+		buffer = new_buffer;
 	}
-	delete[] buffer;
-	buffer = new_buffer;
 	_capacity = new_capacity;
 	_idx_head = 0;
-	_idx_end = _size;
+	_idx_end = (_size == _capacity) ? 0 : _size;
 	isfull = (_size == _capacity);
 }
 
-void CircularBuffer::resize(int new_size, const value_type& item) {
+void CircularBuffer::resize(size_type new_size, const value_type& item) {
 	if (new_size > _capacity) {
 		set_capacity(new_size);
 	}
-	for (int i = _size; i < new_size; ++i) {
+	for (size_type i = _size; i < new_size; ++i) {
 		push_back(item);
 	}
-	_size = new_size;
+	if (_size > new_size) {
+		drop_back(_size - new_size);
+		renumber();
+		watch();
+	}
 }
 
 CircularBuffer& CircularBuffer::operator=(const CircularBuffer& cb) {
 	if (this != &cb) {
-		delete[] buffer;
+		share(cb);
+		watch();
+	}
+	return *this;
+}
+
+CircularBuffer& CircularBuffer::operator=(CircularBuffer&& cb) noexcept {
+	if (this != &cb) {
+		release();
+		if (cb.is_inline()) {
+			std::copy(cb._inline, cb._inline + cb._capacity, _inline);
+		} else {
+			buffer = cb.buffer;
+			_unshareable = cb._unshareable;
+			cb.buffer = cb._inline;
+			cb._unshareable = false;
+		}
 		_capacity = cb._capacity;
 		_size = cb._size;
 		_idx_head = cb._idx_head;
 		_idx_end = cb._idx_end;
-		buffer = new value_type[_capacity];
-		std::copy(cb.buffer, cb.buffer + _capacity, buffer);
+		isfull = cb.isfull;
+		_seq_head = cb._seq_head;
+		_seq_next = cb._seq_next;
+		delete _watermarks;
+		_watermarks = cb._watermarks;
+		_above_high.store(cb._above_high.load(std::memory_order_relaxed), std::memory_order_release);
+
+		cb._capacity = 0;
+		cb._size = 0;
+		cb._idx_head = 0;
+		cb._idx_end = 0;
+		cb.isfull = false;
+		cb._seq_head = 0;
+		cb._seq_next = 0;
+		cb._watermarks = nullptr;
+		cb._above_high.store(false, std::memory_order_release);
 	}
 	return *this;
 }
 
 void CircularBuffer::swap(CircularBuffer& cb) {
+	if (is_inline() || cb.is_inline()) {
+		CircularBuffer tmp(std::move(cb));
+		cb = std::move(*this);
+		*this = std::move(tmp);
+		return;
+	}
 	std::swap(buffer, cb.buffer);
 	std::swap(_capacity, cb._capacity);
 	std::swap(_size, cb._size);
 	std::swap(_idx_head, cb._idx_head);
 	std::swap(_idx_end, cb._idx_end);
+	std::swap(isfull, cb.isfull);
+	std::swap(_unshareable, cb._unshareable);
+	std::swap(_seq_head, cb._seq_head);
+	std::swap(_seq_next, cb._seq_next);
+	std::swap(_watermarks, cb._watermarks);
+	bool above = _above_high.load(std::memory_order_relaxed);
+	_above_high.store(cb._above_high.load(std::memory_order_relaxed), std::memory_order_release);
+	cb._above_high.store(above, std::memory_order_release);
 }
 
 void CircularBuffer::push_back(const value_type& item) {
+	CB_PROFILE(PushBack);
 	if (full()) {
-		pop_front();
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer has zero capacity"));
+		}
+		drop_front(1);
 	}
+	detach();
 	buffer[_idx_end] = item;
 	_size++;
 	_idx_end = (_idx_end + 1) % _capacity;
 	isfull = full();
+	_seq_next++;
+	watch();
 }
 
 void CircularBuffer::push_front(const value_type& item) {
+	bool append = empty();
 	if (full()) {
-		pop_back();
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer has zero capacity"));
+		}
+		drop_back(1);
 	}
+	detach();
 	_idx_head = (_idx_head - 1 + _capacity) % _capacity;
 	buffer[_idx_head] = item; 
 	_size++;
 	isfull = (_size == _capacity);
+	if (append) {
+		_seq_next++;
+	} else {
+		renumber();
+	}
+	watch();
 }
 
 void CircularBuffer::pop_back() {
 	if (empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
-	_idx_end = (_idx_end - 1 + _capacity) % _capacity;
-	_size--;
-	isfull = false;
+	drop_back(1);
+	renumber();
+	watch();
 }
 
 void CircularBuffer::pop_front() {
+	CB_PROFILE(PopFront);
 	if (empty()) {
-		throw std::out_of_range("Buffer is empty");
+		CB_THROW(std::out_of_range("Buffer is empty"));
 	}
 
 	_idx_head = (_idx_head + 1) % _capacity;
 	_size--;
 	isfull = false;
+	_seq_head++;
+	watch();
+}
+
+bool CircularBuffer::try_pop_front() noexcept {
+	if (empty()) {
+		return false;
+	}
+	pop_front();
+	return true;
+}
+
+bool CircularBuffer::try_pop_front(value_type& out) noexcept {
+	if (empty()) {
+		return false;
+	}
+	out = buffer[_idx_head];
+	pop_front();
+	return true;
+}
 
+bool CircularBuffer::try_pop_back() noexcept {
+	if (empty()) {
+		return false;
+	}
+	pop_back();
+	return true;
 }
 
-void CircularBuffer::insert(int pos, const value_type& item){
+bool CircularBuffer::try_pop_back(value_type& out) noexcept {
+	if (empty()) {
+		return false;
+	}
+	out = buffer[(_idx_end - 1 + _capacity) % _capacity];
+	pop_back();
+	return true;
+}
+
+void CircularBuffer::insert(size_type pos, const value_type& item){
+	CB_PROFILE(Insert);
 	if (pos > _size || pos < 0) {
-		throw std::out_of_range("Bad pos!");
+		CB_THROW(std::out_of_range("Bad pos!"));
 	}
 	if (full()) {
-		pop_front();
+		if (pos == 0) {
+			return;
+		}
+		drop_front(1);
+		pos--;
 	}
-	for (int i = _size - 1; i >= pos; --i) {
-		buffer[(_idx_end - 1 + i) % _capacity] = buffer[(_idx_end + i) % _capacity];
+	detach();
+	bool append = pos == _size;
+	for (size_type i = _size; i > pos; --i) {
+		buffer[(_idx_head + i) % _capacity] = buffer[(_idx_head + i - 1) % _capacity];
 	}
 
-	buffer[(_idx_end + pos) % _capacity] = item;
+	buffer[(_idx_head + pos) % _capacity] = item;
 	_size++;
+	_idx_end = (_idx_end + 1) % _capacity;
+	isfull = full();
+	if (append) {
+		_seq_next++;
+	} else {
+		renumber();
+	}
+	watch();
 }
 
-void CircularBuffer::erase(int first, int last) {
+void CircularBuffer::erase(size_type first, size_type last) {
 	if (first >= last || first < 0 || last > _size) {
-		throw std::out_of_range("Index out of range");
+		CB_THROW(std::out_of_range("Index out of range"));
 	}
 	if (_size == 0) {
-		throw std::out_of_range("Buffer is empty, cannot delete elems");
+		CB_THROW(std::out_of_range("Buffer is empty, cannot delete elems"));
 	}
-	int count = last - first;
-	for (int i = first; i < _size - count; i++) {
+	size_type count = last - first;
+	detach();
+	for (size_type i = first; i < _size - count; i++) {
 		buffer[(_idx_head + i) % _capacity] = buffer[(_idx_head + i + count) % _capacity];
 	}
 	_size -= count;
 	_idx_end = (_idx_end - count + _capacity) % _capacity; 
 	isfull = (_size == _capacity); 
+	if (first == 0) {
+		_seq_head += count;
+	} else {
+		renumber();
+	}
+	watch();
 }
 
 void CircularBuffer::clear() {
 	if (empty()) {
-		throw std::underflow_error("Buffer is empty already");
+		CB_THROW(std::underflow_error("Buffer is empty already"));
 	}
+	_seq_head = _seq_next;
 	_size = 0;
 	_idx_head = 0;
 	_idx_end = 0;
 	isfull = false;
+	watch();
+}
 
+void CircularBuffer::drop_front(size_type n) {
+	_idx_head = (_idx_head + n) % _capacity;
+	_size -= n;
+	isfull = (_size == _capacity);
+	_seq_head += n;
+}
+
+void CircularBuffer::drop_back(size_type n) {
+	_idx_end = (_idx_end - n + _capacity) % _capacity;
+	_size -= n;
+	isfull = false;
+}
+
+// Numbers the contents from one past next_seq(), so that every number given
+// out before, including the one a consumer waits for next, reads as overwritten.
+void CircularBuffer::renumber() {
+	_seq_head = _seq_next + 1;
+	_seq_next = _seq_head + _size;
+}
+
+void CircularBuffer::cross_watermarks() {
+	Watermarks& marks = *_watermarks;
+	if (!_above_high.load(std::memory_order_relaxed)) {
+		if (_size >= marks.high) {
+			_above_high.store(true, std::memory_order_release);
+			if (marks.on_high) {
+				marks.on_high();
+			}
+		}
+	} else if (_size <= marks.low) {
+		_above_high.store(false, std::memory_order_release);
+		if (marks.on_low) {
+			marks.on_low();
+		}
+	}
+}
+
+void CircularBuffer::set_watermarks(size_type high, size_type low, std::function<void()> on_high, std::function<void()> on_low) {
+	if (low < 0 || low >= high) {
+		CB_THROW(std::invalid_argument("Watermarks must satisfy 0 <= low < high"));
+	}
+	if (_watermarks == nullptr) {
+		_watermarks = new Watermarks;
+	}
+	_watermarks->high = high;
+	_watermarks->low = low;
+	_above_high.store(false, std::memory_order_release);
+	_watermarks->on_high = std::move(on_high);
+	_watermarks->on_low = std::move(on_low);
+	watch();
+}
+
+void CircularBuffer::clear_watermarks() {
+	delete _watermarks;
+	_watermarks = nullptr;
+	_above_high.store(false, std::memory_order_release);
+}
+
+bool CircularBuffer::above_high_watermark() const noexcept {
+	return _above_high.load(std::memory_order_acquire);
+}
+
+bool CircularBuffer::try_clear() noexcept {
+	if (empty()) {
+		return false;
+	}
+	clear();
+	return true;
 }
 
 bool operator==(const CircularBuffer& a, const CircularBuffer& b) {
 	if (a.size() != b.size()) return false;
 
-	int j = 0;
-	for (int i = 0; i < a.size(); i++) {
+	for (size_type i = 0; i < a.size(); i++) {
 		if (a[i] != b[i]) return false;
 	}
 	return true;
@@ -1,26 +1,170 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <stdexcept>
 
 typedef int value_type;
 
+/**
+ * Signed integer type of sizes, capacities and indices. Defaults to
+ * std::ptrdiff_t so rings can exceed 2^31 elements on 64-bit targets while
+ * negative arguments are still detected; build with -DCB_SIZE_TYPE=int to
+ * get the old 32-bit layout back.
+ */
+#ifndef CB_SIZE_TYPE
+#define CB_SIZE_TYPE std::ptrdiff_t
+#endif
+
+typedef CB_SIZE_TYPE size_type;
+
+/**
+ * Heap storage of at least this many bytes is mapped with mmap(MAP_NORESERVE)
+ * on Linux, so untouched pages of huge rings cost no physical memory.
+ * Can be overridden at build time with -DCB_MMAP_THRESHOLD=<bytes>.
+ */
+#ifndef CB_MMAP_THRESHOLD
+#define CB_MMAP_THRESHOLD (std::size_t(64) << 20)
+#endif
+
+/**
+ * Raise an error. Builds with CB_NO_EXCEPTIONS (the CB_NO_EXCEPTIONS CMake
+ * option) compile the library without exceptions and abort instead; the
+ * noexcept try_* members are the way to handle errors there.
+ */
+#ifdef CB_NO_EXCEPTIONS
+#define CB_THROW(exception) std::abort()
+#else
+#define CB_THROW(exception) throw exception
+#endif
+
+/**
+ * Largest capacity that is stored inline inside the CircularBuffer object.
+ * Buffers up to this capacity never touch the heap; larger ones spill to it.
+ * Can be overridden at build time with -DCB_INLINE_CAPACITY=<n>.
+ */
+#ifndef CB_INLINE_CAPACITY
+#define CB_INLINE_CAPACITY 16
+#endif
+
+static_assert(CB_INLINE_CAPACITY > 0, "CB_INLINE_CAPACITY must be positive");
+
+/**
+ * Non-owning view over a contiguous run of elements stored in a buffer.
+ * Stays valid until the buffer it points into is modified.
+ */
+template <typename T>
+struct Segment {
+	T* data;	// First element of the run
+	size_type size;	// Number of elements in the run
+
+	T* begin() const { return data; }
+	T* end() const { return data + size; }
+	bool empty() const { return size == 0; }
+	T& operator[](size_type i) const { return data[i]; }
+};
+
+/**
+ * A logical range of a ring split at the wrap point into at most two
+ * contiguous segments; first precedes second in logical order.
+ */
+template <typename T>
+struct SegmentPair {
+	Segment<T> first;
+	Segment<T> second;
+
+	size_type size() const { return first.size + second.size; }
+	bool empty() const { return size() == 0; }
+};
+
+typedef std::uint64_t sequence_type;
+
+/**
+ * Thrown when a sequence number refers to an element that has already been
+ * popped or overwritten. oldest() is the first sequence still available, so
+ * a consumer can resume from there and knows how many elements it missed.
+ */
+class sequence_overwritten : public std::out_of_range {
+	sequence_type _oldest;
+
+public:
+	sequence_overwritten(sequence_type requested, sequence_type oldest)
+		: std::out_of_range("Sequence " + std::to_string(requested) + " was overwritten, oldest is " + std::to_string(oldest)),
+		  _oldest(oldest) {}
+
+	sequence_type oldest() const { return _oldest; }
+};
+
 class CircularBuffer {
-	value_type* buffer;	// Pointer to the internal buffer array
-	int _capacity;		// Total capacity of the buffer
-	int _size;			// Current number of elements in the buffer
-	int _idx_head;		// Index of the first element (head) in the buffer
-	int _idx_end;		// Index of the last element (end) in the buffer
+	value_type* buffer;	// Pointer to the internal buffer array (_inline or heap)
+	size_type _capacity;	// Total capacity of the buffer
+	size_type _size;		// Current number of elements in the buffer
+	size_type _idx_head;	// Index of the first element (head) in the buffer
+	size_type _idx_end;		// Index of the last element (end) in the buffer
 	bool isfull;		// Flag indicating whether the buffer is full
+	bool _unshareable;	// Set once a mutable reference into the heap storage was handed out
+	sequence_type _seq_head;	// Sequence number of the first element
+	sequence_type _seq_next;	// Sequence number of the next push_back, only grows
+	struct Watermarks;
+	Watermarks* _watermarks;	// Occupancy thresholds, nullptr when not configured
+	std::atomic<bool> _above_high;	// Set between on_high and the following on_low
+	value_type _inline[CB_INLINE_CAPACITY];	// Inline storage for small capacities
+
+	// Heap storage is reference counted and shared between copies;
+	// the header sits right before the first element.
+	struct alignas(16) SharedHeader {
+		std::atomic<int> refs;
+		std::size_t mapped_bytes;	// Length of the mapping, 0 if allocated with operator new
+	};
+
+	SharedHeader* header() const;
+	value_type* allocate(size_type capacity);
+	void release();
+	void share(const CircularBuffer& cb);
+	void detach();
+	void pin();
+	void drop_front(size_type n);
+	void drop_back(size_type n);
+	void renumber();
+	void watch();
+	void cross_watermarks();
 	
 public:
+	static const int inline_capacity = CB_INLINE_CAPACITY;
+
 	CircularBuffer();
 	~CircularBuffer();
+
+	/**
+     * Copy constructor. Heap storage is shared copy-on-write, so the copy is O(1);
+     * the first mutation of either buffer copies the live elements into its own storage.
+     * Once a non-const reference or pointer into the storage has been handed out
+     * (operator[], at, front, back, at_seq, linearize, segments), the storage is
+     * never shared again and copies are deep, so writes through such a reference
+     * cannot reach a copy. Read through a const reference to keep copies O(1).
+     * @param cb The buffer to copy.
+     */
 	CircularBuffer(const CircularBuffer& cb);
 
+	/**
+     * Move constructor. Heap storage is stolen, inline storage is copied.
+     * The source buffer is left empty with zero capacity.
+     * @param cb The buffer to move from.
+     */
+	CircularBuffer(CircularBuffer&& cb) noexcept;
+
 	/**
      * Constructor to initialize a buffer with a specific capacity.
      * @param capacity The maximum number of elements the buffer can hold.
+     * @throws std::invalid_argument if the capacity is negative.
+     * @throws std::length_error if the storage size does not fit in std::size_t.
      */
-	explicit CircularBuffer(int capacity);
+	explicit CircularBuffer(size_type capacity);
 	
 	/**
      * Constructor to initialize a buffer with a specific capacity, 
@@ -28,15 +172,15 @@ public:
      * @param capacity The maximum number of elements the buffer can hold.
      * @param elem The value to initialize all elements in the buffer.
      */
-	CircularBuffer(int capacity, const value_type& elem);
+	CircularBuffer(size_type capacity, const value_type& elem);
 
 	/**
      * Access an element by index without bounds checking.
      * @param i Index of the element to access.
      * @return Reference to the element at the specified index.
      */
-	value_type& operator[](int i);
-	const value_type& operator[](int i) const;
+	value_type& operator[](size_type i);
+	const value_type& operator[](size_type i) const;
 
 	/**
      * Access an element by index with bounds checking.
@@ -44,8 +188,8 @@ public:
      * @return Reference to the element at the specified index.
      * @throws std::out_of_range if the index is out of bounds.
      */
-	value_type& at(int i);
-	const value_type& at(int i) const;
+	value_type& at(size_type i);
+	const value_type& at(size_type i) const;
 
 	/**
      * Get a reference to the first element in the buffer.
@@ -63,12 +207,75 @@ public:
 	const value_type& back() const;
 	value_type& back();  
 	
+	/**
+     * Non-throwing access to the first element, the last element or an element by index.
+     * @return A copy of the element, or std::nullopt if it does not exist.
+     */
+	std::optional<value_type> try_front() const noexcept;
+	std::optional<value_type> try_back() const noexcept;
+	std::optional<value_type> try_at(size_type i) const noexcept;
+
+	/**
+     * Every element carries an implicit sequence number. Numbers grow along the
+     * buffer and are never handed out twice: push_back gives the new element
+     * next_seq(), while pop_front, overwriting and clear only move first_seq()
+     * forward, so the numbers of the remaining elements do not change.
+     * The other changes (pop_back, push_front into a non-empty buffer, insert
+     * other than at the back, erase other than at the front, rotate, resize
+     * that shrinks) renumber the whole contents starting past every number
+     * given out so far; a consumer holding an older number then gets
+     * sequence_overwritten and resumes from its oldest().
+     */
+
+	/**
+     * Get the sequence number of the first element, or next_seq() if the buffer is empty.
+     */
+	sequence_type first_seq() const;
+
+	/**
+     * Get the sequence number of the last element.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	sequence_type last_seq() const;
+
+	/**
+     * Get the sequence number the next element pushed to the back will get.
+     */
+	sequence_type next_seq() const;
+
+	/**
+     * Access an element by sequence number in O(1).
+     * @param seq Sequence number of the element.
+     * @return Reference to the element.
+     * @throws sequence_overwritten if the element is no longer in the buffer.
+     * @throws std::out_of_range if the element has not been pushed yet.
+     */
+	value_type& at_seq(sequence_type seq);
+	const value_type& at_seq(sequence_type seq) const;
+
+	/**
+     * Get the elements from a sequence number up to the back without copying, in O(1).
+     * Lets a consumer resume after the last sequence it has seen.
+     * @param seq Sequence number of the first element to return; next_seq() gives empty views.
+     * @return Views in logical order, valid until the next modification.
+     * @throws sequence_overwritten if the element is no longer in the buffer.
+     * @throws std::out_of_range if seq is greater than next_seq().
+     */
+	SegmentPair<const value_type> read_from_seq(sequence_type seq) const;
+
 	/**
      * Linearize the buffer to make it contiguous in memory.
      * @return Pointer to the linearized buffer.
      */
 	value_type* linearize();
 	
+	/**
+     * Get the elements as at most two contiguous segments without moving them.
+     * @return Views in logical order, valid until the next modification.
+     */
+	SegmentPair<value_type> segments();
+	SegmentPair<const value_type> segments() const;
+
 	/**
      * Check if the buffer is already linearized.
      * @return True if the buffer is linearized, false otherwise.
@@ -80,13 +287,13 @@ public:
      * @param new_begin The index of the new beginning of the buffer.
      * @throws std::out_of_range if the index is invalid.
      */
-	void rotate(int new_begin);
+	void rotate(size_type new_begin);
 	
 	/**
      * Get the current number of elements in the buffer.
      * @return Number of elements in the buffer.
      */
-	int size() const;
+	size_type size() const;
 
 	/**
      * Check if the buffer is empty.
@@ -105,21 +312,36 @@ public:
      * Get the number of remaining slots in the buffer.
      * @return Number of unused slots in the buffer.
      */
-	int reserve() const;
+	size_type reserve() const;
 	
 	/**
      * Get the total capacity of the buffer.
      * @return The maximum number of elements the buffer can hold.
      */
-	int capacity() const;
+	size_type capacity() const;
+
+	/**
+     * Check if the elements are kept in the inline storage of the object.
+     * @return True if no heap allocation backs the buffer, false otherwise.
+     */
+	bool is_inline() const;
+
+	/**
+     * Check if the heap storage is shared with a copy of this buffer.
+     * Non-const element access and modifications detach shared storage first.
+     * @return True if another buffer references the same storage, false otherwise.
+     */
+	bool is_shared() const;
 
 	/**
      * Change the buffer capacity. 
      * The size must not exceed the new capacity.
+     * Storage moves to the heap when the new capacity exceeds inline_capacity
+     * and back inline when it fits again.
      * @param new_capacity The new capacity for the buffer.
      * @throws std::invalid_argument if the new capacity is smaller than the current size.
      */
-	void set_capacity(int new_capacity);
+	void set_capacity(size_type new_capacity);
 	
 	/**
      * Resize the buffer to hold a specific number of elements.
@@ -127,14 +349,22 @@ public:
      * @param new_size The new size of the buffer.
      * @param item The value to initialize new elements if the buffer is expanded.
      */
-	void resize(int new_size, const value_type& item = value_type());
+	void resize(size_type new_size, const value_type& item = value_type());
 	
 	/**
      * Assignment operator for copying another buffer into this one.
+     * Heap storage is shared copy-on-write under the same rules as the copy constructor.
      * @param cb The source buffer to copy.
      * @return Reference to the updated buffer.
      */
 	CircularBuffer& operator=(const CircularBuffer& cb);
+
+	/**
+     * Move assignment operator.
+     * @param cb The source buffer to move from, left empty with zero capacity.
+     * @return Reference to the updated buffer.
+     */
+	CircularBuffer& operator=(CircularBuffer&& cb) noexcept;
 	
 	/**
      * Swap the contents of this buffer with another buffer.
@@ -168,13 +398,23 @@ public:
      */
 	void pop_front();
 
+	/**
+     * Non-throwing removal of the first or the last element.
+     * @param out Receives the removed element.
+     * @return True if an element was removed, false if the buffer is empty.
+     */
+	bool try_pop_front() noexcept;
+	bool try_pop_front(value_type& out) noexcept;
+	bool try_pop_back() noexcept;
+	bool try_pop_back(value_type& out) noexcept;
+
 	/**
      * Insert an element at a specific position in the buffer.
      * @param pos The position where the element will be inserted.
      * @param item The value to insert.
      * @throws std::out_of_range if the position is invalid.
      */
-	void insert(int pos, const value_type& item = value_type());
+	void insert(size_type pos, const value_type& item = value_type());
 	
 	/**
      * Remove a range of elements from the buffer.
@@ -182,15 +422,100 @@ public:
      * @param last The end of the range to remove (exclusive).
      * @throws std::out_of_range if the range is invalid.
      */
-	void erase(int first, int last);
+	void erase(size_type first, size_type last);
 	
 	/**
      * Clear the buffer, removing all elements.
      * @throws std::underflow_error if the buffer is already empty.
      */
 	void clear();
+
+	/**
+     * Non-throwing clear.
+     * @return True if elements were removed, false if the buffer was already empty.
+     */
+	bool try_clear() noexcept;
+
+	/**
+     * Configure occupancy watermarks for backpressure. on_high fires once when
+     * the size rises to high; after that on_low fires once when the size falls
+     * to low, and so on. Between the two thresholds nothing fires, so producers
+     * can pause on high and resume on low without polling size() on every push.
+     * If the size is already at or above high, on_high fires immediately.
+     * Callbacks run synchronously inside the modifying call and must not throw.
+     * Watermarks belong to the buffer object: copies do not inherit them,
+     * moves and swap carry them along.
+     * @param high Size at which on_high fires.
+     * @param low Size at which on_low fires, less than high.
+     * @param on_high Called when the high watermark is reached, may be empty.
+     * @param on_low Called when the size drops back to the low watermark, may be empty.
+     * @throws std::invalid_argument if low is negative or not less than high.
+     */
+	void set_watermarks(size_type high, size_type low, std::function<void()> on_high = std::function<void()>(),
+		std::function<void()> on_low = std::function<void()>());
+
+	/**
+     * Remove the watermarks; no callbacks fire afterwards.
+     */
+	void clear_watermarks();
+
+	/**
+     * Check if the high watermark was reached and the low one not yet.
+     * The flag is an atomic member of the buffer itself, so other threads can
+     * poll it while the owner reconfigures or removes the watermarks.
+     * @return True between on_high and the following on_low, false without watermarks.
+     */
+	bool above_high_watermark() const noexcept;
+
+	/**
+     * Pass up to max_n elements from the front to a callback and remove them.
+     * The callback is invoked once per contiguous segment (at most twice) with
+     * a pointer to the elements and their count; the head is advanced once
+     * afterwards. If the callback throws, nothing is removed.
+     * @param max_n Maximum number of elements to consume.
+     * @param callback Callable taking (const value_type* data, size_type n).
+     * @return Number of elements consumed.
+     */
+	template <typename Callback>
+	size_type consume(size_type max_n, Callback callback);
+
+	/**
+     * Pass all elements to a callback segment by segment and remove them.
+     * @param callback Callable taking (const value_type* data, size_type n).
+     * @return Number of elements consumed.
+     */
+	template <typename Callback>
+	size_type consume_all(Callback callback);
 };
 
+inline void CircularBuffer::watch() {
+	if (_watermarks != nullptr) {
+		cross_watermarks();
+	}
+}
+
+template <typename Callback>
+size_type CircularBuffer::consume(size_type max_n, Callback callback) {
+	SegmentPair<const value_type> live = static_cast<const CircularBuffer*>(this)->segments();
+	size_type n = max_n < live.size() ? max_n : live.size();
+	if (n <= 0) {
+		return 0;
+	}
+	size_type first_n = n < live.first.size ? n : live.first.size;
+	callback(live.first.data, first_n);
+	if (n > first_n) {
+		callback(live.second.data, n - first_n);
+	}
+	drop_front(n);
+	watch();
+	return n;
+}
+
+template <typename Callback>
+size_type CircularBuffer::consume_all(Callback callback) {
+	return consume(_size, callback);
+}
+
 /**
  * Compare two buffers for equality.
  * @param a The first buffer.
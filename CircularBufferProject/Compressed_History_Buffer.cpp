@@ -0,0 +1,236 @@
+#include<algorithm>
+#include<stdexcept>
+#include"Compressed_History_Buffer.h"
+
+namespace {
+
+typedef void (*unpack_kernel)(const std::uint64_t* words, std::uint32_t* out);
+
+// Unpacks block_size values of W bits. W is a compile-time constant so shifts
+// and masks fold and the compiler can unroll and vectorize the loop.
+template <int W>
+void unpack(const std::uint64_t* words, std::uint32_t* out) {
+	const std::uint64_t mask = (W == 32) ? 0xFFFFFFFFull : ((1ull << W) - 1);
+	for (int i = 0; i < CompressedHistoryBuffer::block_size; i++) {
+		const int bit = i * W;
+		const int shift = bit & 63;
+		std::uint64_t v = words[bit >> 6] >> shift;
+		if (shift + W > 64) {
+			v |= words[(bit >> 6) + 1] << (64 - shift);
+		}
+		out[i] = static_cast<std::uint32_t>(v & mask);
+	}
+}
+
+template <>
+void unpack<0>(const std::uint64_t*, std::uint32_t* out) {
+	std::fill(out, out + CompressedHistoryBuffer::block_size, 0u);
+}
+
+template <int... W>
+struct KernelTable {
+	static constexpr unpack_kernel kernels[] = { &unpack<W>... };
+};
+
+typedef KernelTable<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32> Kernels;
+
+std::uint32_t zigzag(std::uint32_t delta) {
+	return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+std::uint32_t unzigzag(std::uint32_t z) {
+	return (z >> 1) ^ (0u - (z & 1));
+}
+
+// Number of 64-bit words holding block_size deltas of the given width.
+int block_words(int width) {
+	return CompressedHistoryBuffer::block_size * width / 64;
+}
+
+int bit_width(std::uint32_t v) {
+	int width = 0;
+	while (v != 0) {
+		width++;
+		v >>= 1;
+	}
+	return width;
+}
+
+}
+
+
+CompressedHistoryBuffer::CompressedHistoryBuffer(int capacity) {
+	if (capacity < 0) {
+		CB_THROW(std::invalid_argument("Capacity must be non-negative"));
+	}
+	_max_blocks = (capacity + block_size - 1) / block_size;
+	_blocks.resize(_max_blocks);
+	_block_head = 0;
+	_block_count = 0;
+	_arena_tail = 0;
+	_tail_size = 0;
+}
+
+std::size_t CompressedHistoryBuffer::place(int words) {
+	const std::size_t size = _arena.size();
+	if (size == 0) {
+		relocate(words);
+		return _arena_tail;
+	}
+	const std::size_t head = _block_count > 0 ? _blocks[_block_head].pos : _arena_tail;
+	std::size_t pos = _arena_tail;
+	// A block never wraps around the end of the arena, skip to its beginning
+	if (pos % size + words > size) {
+		pos += size - pos % size;
+	}
+	if (pos + words - head > size) {
+		relocate(words);
+		return _arena_tail;
+	}
+	return pos;
+}
+
+void CompressedHistoryBuffer::relocate(int words) {
+	// Slack of two full-width blocks covers the gap left when the ring wraps
+	const std::size_t slack = 2 * block_words(32);
+	std::size_t live = 0;
+	for (int b = 0; b < _block_count; b++) {
+		live += block_words(_blocks[(_block_head + b) % _max_blocks].width);
+	}
+	std::size_t size = _arena.size();
+	if (live + words + slack > size) {
+		size = std::max(size + size / 2, live + words + slack);
+		size = std::min(size, static_cast<std::size_t>(_max_blocks) * block_words(32) + slack);
+	}
+
+	std::vector<std::uint64_t> arena(size);
+	std::size_t pos = 0;
+	for (int b = 0; b < _block_count; b++) {
+		Block& block = _blocks[(_block_head + b) % _max_blocks];
+		const std::uint64_t* src = _arena.data() + block.pos % _arena.size();
+		std::copy(src, src + block_words(block.width), arena.data() + pos);
+		block.pos = pos;
+		pos += block_words(block.width);
+	}
+	_arena.swap(arena);
+	_arena_tail = pos;
+}
+
+void CompressedHistoryBuffer::seal() {
+	std::uint32_t deltas[block_size];
+	std::uint32_t prev = static_cast<std::uint32_t>(_tail[0]);
+	std::uint32_t bits = 0;
+	for (int i = 0; i < block_size; i++) {
+		std::uint32_t cur = static_cast<std::uint32_t>(_tail[i]);
+		deltas[i] = zigzag(cur - prev);
+		bits |= deltas[i];
+		prev = cur;
+	}
+
+	// Evict first so the oldest block's words are free for the new one
+	if (_block_count == _max_blocks) {
+		_block_head = (_block_head + 1) % _max_blocks;
+		_block_count--;
+	}
+	const int w = bit_width(bits);
+	const int n = block_words(w);
+	const std::size_t pos = place(n);
+
+	Block& block = _blocks[(_block_head + _block_count) % _max_blocks];
+	_block_count++;
+	block.base = _tail[0];
+	block.width = w;
+	block.pos = pos;
+	_arena_tail = pos + n;
+
+	std::uint64_t* words = _arena.data() + pos % _arena.size();
+	std::fill(words, words + n, 0);
+	if (w > 0) {
+		for (int i = 0; i < block_size; i++) {
+			const int bit = i * w;
+			const int shift = bit & 63;
+			words[bit >> 6] |= static_cast<std::uint64_t>(deltas[i]) << shift;
+			if (shift + w > 64) {
+				words[(bit >> 6) + 1] |= static_cast<std::uint64_t>(deltas[i]) >> (64 - shift);
+			}
+		}
+	}
+	_tail_size = 0;
+}
+
+void CompressedHistoryBuffer::decode(const Block& block, value_type* out) const {
+	std::uint32_t deltas[block_size];
+	Kernels::kernels[block.width](_arena.data() + block.pos % _arena.size(), deltas);
+	std::uint32_t cur = static_cast<std::uint32_t>(block.base);
+	for (int i = 0; i < block_size; i++) {
+		cur += unzigzag(deltas[i]);
+		out[i] = static_cast<value_type>(cur);
+	}
+}
+
+void CompressedHistoryBuffer::push_back(const value_type& item) {
+	if (_max_blocks == 0) {
+		return;
+	}
+	_tail[_tail_size++] = item;
+	if (_tail_size == block_size) {
+		seal();
+	}
+}
+
+value_type CompressedHistoryBuffer::at(int i) const {
+	value_type item;
+	read(i, 1, &item);
+	return item;
+}
+
+void CompressedHistoryBuffer::read(int first, int count, value_type* out) const {
+	if (first < 0 || count < 0 || first + count > size()) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	value_type decoded[block_size];
+	const int sealed = _block_count * block_size;
+	while (count > 0 && first < sealed) {
+		const int b = first / block_size;
+		const int offset = first % block_size;
+		const int n = std::min(count, block_size - offset);
+		if (offset == 0 && n == block_size) {
+			decode(_blocks[(_block_head + b) % _max_blocks], out);
+		} else {
+			decode(_blocks[(_block_head + b) % _max_blocks], decoded);
+			std::copy(decoded + offset, decoded + offset + n, out);
+		}
+		out += n;
+		first += n;
+		count -= n;
+	}
+	if (count > 0) {
+		std::copy(_tail + (first - sealed), _tail + (first - sealed) + count, out);
+	}
+}
+
+int CompressedHistoryBuffer::size() const {
+	return _block_count * block_size + _tail_size;
+}
+
+bool CompressedHistoryBuffer::empty() const {
+	return size() == 0;
+}
+
+int CompressedHistoryBuffer::capacity() const {
+	return _max_blocks == 0 ? 0 : _max_blocks * block_size + block_size - 1;
+}
+
+std::size_t CompressedHistoryBuffer::memory_bytes() const {
+	return sizeof(_tail)
+		+ _blocks.capacity() * sizeof(Block)
+		+ _arena.capacity() * sizeof(std::uint64_t);
+}
+
+void CompressedHistoryBuffer::clear() {
+	_block_head = 0;
+	_block_count = 0;
+	_arena_tail = 0;
+	_tail_size = 0;
+}
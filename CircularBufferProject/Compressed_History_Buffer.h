@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Append-only history of integer samples stored in compressed blocks.
+ * New samples go to a raw staging block; once it holds block_size samples it
+ * is sealed with delta + zigzag + bit-packing, so slowly varying counters take
+ * a few bits per sample instead of 32. When the ring of sealed blocks is full
+ * the oldest whole block is evicted. Packed words of all blocks share one arena
+ * filled as a ring instead of an allocation per block. Range reads decode a
+ * block at a time with unpack kernels specialized per bit width.
+ */
+class CompressedHistoryBuffer {
+public:
+	static const int block_size = 128;
+
+private:
+	struct Block {
+		value_type base;	// First sample of the block
+		int width;			// Bits per packed zigzag delta
+		std::size_t pos;	// Position of the packed words in the arena, not wrapped
+	};
+
+	std::vector<Block> _blocks;				// Ring of sealed blocks
+	int _max_blocks;						// Capacity of the ring in blocks
+	int _block_head;						// Index of the oldest sealed block
+	int _block_count;						// Number of sealed blocks
+	std::vector<std::uint64_t> _arena;		// Packed words of all sealed blocks, used as a ring
+	std::size_t _arena_tail;				// Position right after the newest block's words
+	value_type _tail[block_size];			// Samples not sealed yet
+	int _tail_size;							// Number of samples in _tail
+
+	std::size_t place(int words);
+	void relocate(int words);
+	void seal();
+	void decode(const Block& block, value_type* out) const;
+
+public:
+	/**
+     * Constructor to initialize a history of at least the given number of samples.
+     * @param capacity Minimum number of most recent samples kept, rounded up to whole blocks.
+     * @throws std::invalid_argument if the capacity is negative.
+     */
+	explicit CompressedHistoryBuffer(int capacity);
+
+	/**
+     * Add a sample to the end of the history.
+     * Evicts the oldest block when the history is full.
+     * @param item The sample to add.
+     */
+	void push_back(const value_type& item);
+
+	/**
+     * Decode a single sample. Decodes the whole block containing it.
+     * @param i Index of the sample, 0 is the oldest.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	value_type at(int i) const;
+
+	/**
+     * Decode a range of samples.
+     * @param first Index of the first sample to decode.
+     * @param count Number of samples to decode.
+     * @param out Destination for count samples.
+     * @throws std::out_of_range if the range is invalid.
+     */
+	void read(int first, int count, value_type* out) const;
+
+	/**
+     * Get the number of samples currently kept.
+     */
+	int size() const;
+
+	bool empty() const;
+
+	/**
+     * Get the maximum number of samples kept: whole sealed blocks plus the staging block.
+     */
+	int capacity() const;
+
+	/**
+     * Get the number of bytes held by the history: the block ring, the word arena
+     * and the staging block. The arena keeps its size after narrower blocks
+     * replace wider ones, and so does the reported value.
+     */
+	std::size_t memory_bytes() const;
+
+	/**
+     * Clear the history, removing all samples.
+     */
+	void clear();
+};
@@ -0,0 +1,68 @@
+#include<algorithm>
+#include"Fir_Filter.h"
+
+
+FirFilter::FirFilter(const std::vector<float>& taps) {
+	if (taps.empty()) {
+		CB_THROW(std::invalid_argument("Filter needs at least one tap"));
+	}
+	_taps.assign(taps.rbegin(), taps.rend());
+	_window.assign(2 * taps.size(), 0.0f);
+	_pos = 0;
+}
+
+float FirFilter::dot(const float* a, const float* b, int n) {
+	// Eight independent sums break the dependency chain of a single
+	// accumulator and map onto one or two vector registers.
+	float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		for (int k = 0; k < 8; k++) {
+			acc[k] += a[i + k] * b[i + k];
+		}
+	}
+	float sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+	for (; i < n; i++) {
+		sum += a[i] * b[i];
+	}
+	return sum;
+}
+
+float FirFilter::push(value_type sample) {
+	int k = taps();
+	float x = static_cast<float>(sample);
+	_window[_pos] = x;
+	_window[_pos + k] = x;
+	_pos = _pos + 1 == k ? 0 : _pos + 1;
+	return dot(_taps.data(), _window.data() + _pos, k);
+}
+
+void FirFilter::process(const value_type* in, size_type n, float* out) {
+	if (n <= 0) {
+		return;
+	}
+	int k = taps();
+	_scratch.resize(static_cast<std::size_t>(k - 1 + n));
+	// The k - 1 newest samples of the window, oldest first.
+	std::copy(_window.begin() + _pos + 1, _window.begin() + _pos + k, _scratch.begin());
+	for (size_type i = 0; i < n; i++) {
+		_scratch[k - 1 + i] = static_cast<float>(in[i]);
+	}
+	for (size_type i = 0; i < n; i++) {
+		out[i] = dot(_taps.data(), _scratch.data() + i, k);
+	}
+	// The last k samples of the scratch become the new window.
+	const float* last = _scratch.data() + n - 1;
+	std::copy(last, last + k, _window.begin());
+	std::copy(last, last + k, _window.begin() + k);
+	_pos = 0;
+}
+
+int FirFilter::taps() const {
+	return static_cast<int>(_taps.size());
+}
+
+void FirFilter::reset() {
+	std::fill(_window.begin(), _window.end(), 0.0f);
+	_pos = 0;
+}
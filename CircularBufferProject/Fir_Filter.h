@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Streaming FIR filter over integer samples with float taps.
+ * The last K samples are kept in a mirrored window of 2K floats: every
+ * sample is written twice, K apart, so the current window is always one
+ * contiguous run and the dot product never has to handle the wrap. The dot
+ * product uses several independent accumulators, which lets the compiler
+ * keep them in vector registers. Block mode filters many samples per call;
+ * it pairs naturally with CircularBuffer::consume(), which hands out the
+ * ring contents segment by segment.
+ */
+class FirFilter {
+	std::vector<float> _taps;		// Taps in reverse order, so the oldest sample meets the last tap
+	std::vector<float> _window;		// Last K samples, mirrored: _window[i] == _window[i + K]
+	std::vector<float> _scratch;	// Block mode input: K - 1 samples of history, then the block
+	int _pos;						// Index in _window of the oldest sample
+
+	static float dot(const float* a, const float* b, int n);
+
+public:
+	/**
+     * Constructor to initialize a filter with zero history.
+     * @param taps Filter coefficients, taps[0] applies to the newest sample.
+     * @throws std::invalid_argument if there are no taps.
+     */
+	explicit FirFilter(const std::vector<float>& taps);
+
+	/**
+     * Feed one sample.
+     * @param sample The new sample.
+     * @return Filter output for the window ending at this sample.
+     */
+	float push(value_type sample);
+
+	/**
+     * Feed a block of samples; equivalent to calling push() for each of them.
+     * @param in The new samples.
+     * @param n Number of samples.
+     * @param out Destination for n outputs.
+     */
+	void process(const value_type* in, size_type n, float* out);
+
+	/**
+     * Get the number of taps.
+     */
+	int taps() const;
+
+	/**
+     * Forget the history; the window is filled with zeros.
+     */
+	void reset();
+};
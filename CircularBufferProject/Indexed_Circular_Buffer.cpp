@@ -0,0 +1,133 @@
+#include<algorithm>
+#include"Indexed_Circular_Buffer.h"
+
+
+IndexedCircularBuffer::IndexedCircularBuffer(size_type capacity, IndexMode mode, size_type counters, int hashes)
+	: _ring(capacity) {
+	if (hashes <= 0) {
+		CB_THROW(std::invalid_argument("Number of hashes must be positive"));
+	}
+	_mode = mode;
+	_hashes = hashes;
+	if (mode == IndexMode::Exact) {
+		_counts.reserve(static_cast<std::size_t>(capacity));
+		return;
+	}
+	std::size_t wanted = counters > 0 ? static_cast<std::size_t>(counters) : std::max<std::size_t>(8 * capacity, 64);
+	std::size_t size = 1;
+	while (size < wanted) {
+		size <<= 1;
+	}
+	_counters.assign(size, 0);
+}
+
+std::size_t IndexedCircularBuffer::counter(const value_type& value, int k) const {
+	// Double hashing over one 64-bit mix of the value.
+	std::uint64_t h = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+	h += 0x9e3779b97f4a7c15ull;
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+	h ^= h >> 31;
+	std::uint64_t h1 = h;
+	std::uint64_t h2 = (h >> 32) | 1;
+	return static_cast<std::size_t>((h1 + k * h2) & (_counters.size() - 1));
+}
+
+void IndexedCircularBuffer::add(const value_type& value) {
+	if (_mode == IndexMode::Exact) {
+		_counts[value]++;
+		return;
+	}
+	for (int k = 0; k < _hashes; k++) {
+		std::uint8_t& c = _counters[counter(value, k)];
+		if (c != 255) {
+			c++;
+		}
+	}
+}
+
+void IndexedCircularBuffer::remove(const value_type& value) {
+	if (_mode == IndexMode::Exact) {
+		auto it = _counts.find(value);
+		if (--it->second == 0) {
+			_counts.erase(it);
+		}
+		return;
+	}
+	for (int k = 0; k < _hashes; k++) {
+		std::uint8_t& c = _counters[counter(value, k)];
+		if (c != 255) {
+			c--;
+		}
+	}
+}
+
+void IndexedCircularBuffer::push_back(const value_type& item) {
+	if (_ring.full() && !_ring.empty()) {
+		remove(_ring.front());
+	}
+	_ring.push_back(item);
+	add(item);
+}
+
+void IndexedCircularBuffer::pop_front() {
+	if (_ring.empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	remove(_ring.front());
+	_ring.pop_front();
+}
+
+void IndexedCircularBuffer::pop_back() {
+	if (_ring.empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	remove(_ring.back());
+	_ring.pop_back();
+}
+
+void IndexedCircularBuffer::clear() {
+	_ring.try_clear();
+	_counts.clear();
+	std::fill(_counters.begin(), _counters.end(), 0);
+}
+
+bool IndexedCircularBuffer::contains(const value_type& value) const {
+	return count(value) > 0;
+}
+
+int IndexedCircularBuffer::count(const value_type& value) const {
+	if (_mode == IndexMode::Exact) {
+		auto it = _counts.find(value);
+		return it == _counts.end() ? 0 : it->second;
+	}
+	int result = 255;
+	for (int k = 0; k < _hashes; k++) {
+		result = std::min<int>(result, _counters[counter(value, k)]);
+	}
+	return result;
+}
+
+const CircularBuffer& IndexedCircularBuffer::ring() const {
+	return _ring;
+}
+
+size_type IndexedCircularBuffer::size() const {
+	return _ring.size();
+}
+
+size_type IndexedCircularBuffer::capacity() const {
+	return _ring.capacity();
+}
+
+bool IndexedCircularBuffer::empty() const {
+	return _ring.empty();
+}
+
+bool IndexedCircularBuffer::full() const {
+	return _ring.full();
+}
+
+IndexMode IndexedCircularBuffer::mode() const {
+	return _mode;
+}
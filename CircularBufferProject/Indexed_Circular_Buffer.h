@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Kind of membership index kept by IndexedCircularBuffer.
+ */
+enum class IndexMode {
+	Exact,			// Hash map of counts: exact answers, a map node per distinct value
+	CountingBloom	// Counting Bloom filter: fixed memory, false positives possible
+};
+
+/**
+ * CircularBuffer with a companion index over the values currently in the
+ * window, answering "was this seen among the last N" in O(1) instead of a
+ * linear scan. The index is updated on every push, pop and overwrite. In
+ * CountingBloom mode contains() may report a value that is not present
+ * (never the other way round) and count() is an upper bound; counters that
+ * reach 255 stick there, so they never cause false negatives.
+ */
+class IndexedCircularBuffer {
+	CircularBuffer _ring;								// The window itself
+	IndexMode _mode;									// Kind of index
+	std::unordered_map<value_type, int> _counts;		// Exact mode: occurrences per value
+	std::vector<std::uint8_t> _counters;				// Bloom mode: saturating counters
+	int _hashes;										// Bloom mode: counters per value
+
+	std::size_t counter(const value_type& value, int k) const;
+	void add(const value_type& value);
+	void remove(const value_type& value);
+
+public:
+	static constexpr int default_hashes = 4;
+
+	/**
+     * Constructor to initialize an empty window.
+     * @param capacity Number of most recent values kept.
+     * @param mode Kind of index.
+     * @param counters Bloom mode: number of counters, rounded up to a power of two;
+     *     0 picks 8 per element of capacity.
+     * @param hashes Bloom mode: counters touched per value.
+     * @throws std::invalid_argument if capacity is negative or hashes is not positive.
+     */
+	explicit IndexedCircularBuffer(size_type capacity, IndexMode mode = IndexMode::Exact,
+		size_type counters = 0, int hashes = default_hashes);
+
+	/**
+     * Add a value to the end of the window.
+     * If the window is full, the oldest value is overwritten and leaves the index.
+     */
+	void push_back(const value_type& item);
+
+	/**
+     * Remove the oldest or the newest value.
+     * @throws std::out_of_range if the window is empty.
+     */
+	void pop_front();
+	void pop_back();
+
+	/**
+     * Remove all values.
+     */
+	void clear();
+
+	/**
+     * Check if a value is in the window, in O(1).
+     */
+	bool contains(const value_type& value) const;
+
+	/**
+     * Get the number of occurrences of a value in the window, in O(1).
+     * Exact in Exact mode, an upper bound in CountingBloom mode.
+     */
+	int count(const value_type& value) const;
+
+	/**
+     * Get read-only access to the window.
+     */
+	const CircularBuffer& ring() const;
+
+	size_type size() const;
+	size_type capacity() const;
+	bool empty() const;
+	bool full() const;
+	IndexMode mode() const;
+};
@@ -0,0 +1,174 @@
+#include<stdexcept>
+#include<time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include<x86intrin.h>
+#endif
+#include"Circular_Buffer.h"
+#include"Latency_Histogram.h"
+
+
+LatencyHistogram::LatencyHistogram() {
+	reset();
+}
+
+int LatencyHistogram::bucket_of(std::uint64_t value) {
+	if (value < static_cast<std::uint64_t>(sub_bucket_count)) {
+		return static_cast<int>(value);
+	}
+	int exponent = 63 - __builtin_clzll(value);
+	int sub = static_cast<int>((value >> (exponent - sub_bucket_bits)) & (sub_bucket_count - 1));
+	return (exponent - sub_bucket_bits + 1) * sub_bucket_count + sub;
+}
+
+std::uint64_t LatencyHistogram::highest_in_bucket(int bucket) {
+	if (bucket < sub_bucket_count) {
+		return static_cast<std::uint64_t>(bucket);
+	}
+	int exponent = bucket / sub_bucket_count + sub_bucket_bits - 1;
+	std::uint64_t sub = static_cast<std::uint64_t>(bucket % sub_bucket_count) | sub_bucket_count;
+	int shift = exponent - sub_bucket_bits;
+	return (sub << shift) + ((1ull << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t value) {
+	counts[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+	_total.fetch_add(1, std::memory_order_relaxed);
+	_sum.fetch_add(value, std::memory_order_relaxed);
+	std::uint64_t current = _max.load(std::memory_order_relaxed);
+	while (value > current && !_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+
+std::uint64_t LatencyHistogram::percentile(double percentile) const {
+	std::uint64_t total = count();
+	if (total == 0) {
+		return 0;
+	}
+	double wanted = percentile / 100.0 * static_cast<double>(total);
+	std::uint64_t target = static_cast<std::uint64_t>(wanted);
+	if (static_cast<double>(target) < wanted || target == 0) {
+		target++;
+	}
+	std::uint64_t seen = 0;
+	for (int bucket = 0; bucket < bucket_count; bucket++) {
+		seen += counts[bucket].load(std::memory_order_relaxed);
+		if (seen >= target) {
+			std::uint64_t highest = highest_in_bucket(bucket);
+			return highest < max() ? highest : max();
+		}
+	}
+	return max();
+}
+
+std::uint64_t LatencyHistogram::count() const {
+	return _total.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::max() const {
+	return _max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+	std::uint64_t total = count();
+	return total == 0 ? 0.0 : static_cast<double>(_sum.load(std::memory_order_relaxed)) / total;
+}
+
+void LatencyHistogram::reset() {
+	for (int bucket = 0; bucket < bucket_count; bucket++) {
+		counts[bucket].store(0, std::memory_order_relaxed);
+	}
+	_total.store(0, std::memory_order_relaxed);
+	_sum.store(0, std::memory_order_relaxed);
+	_max.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::dump(std::ostream& out) const {
+	out << "count=" << count()
+	    << " mean=" << mean()
+	    << " p50=" << percentile(50)
+	    << " p90=" << percentile(90)
+	    << " p99=" << percentile(99)
+	    << " p99.9=" << percentile(99.9)
+	    << " max=" << max();
+}
+
+namespace {
+
+std::atomic<int> profiler_sample_rate(64);
+
+LatencyHistogram profiler_histograms[static_cast<int>(ProfiledOp::Count)];
+
+const char* const profiler_op_names[] = { "push_back", "pop_front", "insert", "set_capacity" };
+
+thread_local int profiler_countdown[static_cast<int>(ProfiledOp::Count)] = {};
+
+}
+
+void OperationProfiler::set_sample_rate(int every_n) {
+	if (every_n <= 0) {
+		CB_THROW(std::invalid_argument("Sample rate must be positive"));
+	}
+	profiler_sample_rate.store(every_n, std::memory_order_relaxed);
+}
+
+int OperationProfiler::sample_rate() {
+	return profiler_sample_rate.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram& OperationProfiler::histogram(ProfiledOp op) {
+	return profiler_histograms[static_cast<int>(op)];
+}
+
+void OperationProfiler::dump(std::ostream& out) {
+	for (int op = 0; op < static_cast<int>(ProfiledOp::Count); op++) {
+		out << profiler_op_names[op] << ": ";
+		profiler_histograms[op].dump(out);
+		out << "\n";
+	}
+}
+
+void OperationProfiler::reset() {
+	for (int op = 0; op < static_cast<int>(ProfiledOp::Count); op++) {
+		profiler_histograms[op].reset();
+	}
+}
+
+std::uint64_t OperationProfiler::now() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+#endif
+}
+
+bool OperationProfiler::should_sample(ProfiledOp op) {
+	int& countdown = profiler_countdown[static_cast<int>(op)];
+	int rate = sample_rate();
+	if (countdown > rate) {
+		countdown = rate;
+	}
+	if (--countdown > 0) {
+		return false;
+	}
+	countdown = rate;
+	return true;
+}
+
+thread_local bool ProfileScope::active = false;
+
+ProfileScope::ProfileScope(ProfiledOp op) : _op(op), _start(0), _sampled(false) {
+	if (!active && OperationProfiler::should_sample(op)) {
+		active = true;
+		_sampled = true;
+		_start = OperationProfiler::now();
+	}
+}
+
+ProfileScope::~ProfileScope() {
+	if (_sampled) {
+		OperationProfiler::histogram(_op).record(OperationProfiler::now() - _start);
+		active = false;
+	}
+}
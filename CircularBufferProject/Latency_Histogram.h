@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+
+/**
+ * Log-linear latency histogram in the HDR style: values below 2^sub_bucket_bits
+ * are counted exactly, larger ones in 2^sub_bucket_bits linear sub-buckets per
+ * power of two, so every recorded value keeps about 3% relative precision.
+ * Recording is lock-free and may happen from several threads at once.
+ */
+class LatencyHistogram {
+public:
+	static const int sub_bucket_bits = 5;
+	static const int sub_bucket_count = 1 << sub_bucket_bits;
+	static const int bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+private:
+	std::atomic<std::uint64_t> counts[bucket_count];	// Number of values per bucket
+	std::atomic<std::uint64_t> _total;					// Number of recorded values
+	std::atomic<std::uint64_t> _sum;					// Sum of recorded values
+	std::atomic<std::uint64_t> _max;					// Largest recorded value
+
+	static int bucket_of(std::uint64_t value);
+	static std::uint64_t highest_in_bucket(int bucket);
+
+public:
+	LatencyHistogram();
+
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	/**
+     * Add a value to the histogram.
+     * @param value The measured latency in ticks.
+     */
+	void record(std::uint64_t value);
+
+	/**
+     * Get the value below or at which the given share of recorded values lie.
+     * @param percentile Share in percent, from 0 to 100.
+     * @return Upper bound of the bucket reaching the percentile, 0 if the histogram is empty.
+     */
+	std::uint64_t percentile(double percentile) const;
+
+	std::uint64_t count() const;
+	std::uint64_t max() const;
+	double mean() const;
+
+	/**
+     * Remove all recorded values.
+     */
+	void reset();
+
+	/**
+     * Print count, mean, p50, p90, p99, p99.9 and max on one line.
+     * @param out The stream to print to.
+     */
+	void dump(std::ostream& out) const;
+};
+
+/**
+ * CircularBuffer operations timed by the profiling build.
+ */
+enum class ProfiledOp {
+	PushBack,
+	PopFront,
+	Insert,
+	SetCapacity,
+	Count
+};
+
+/**
+ * Collects sampled latencies of CircularBuffer operations when the library is
+ * built with CB_PROFILING. One of every sample_rate() calls of each thread is
+ * timed with the cycle counter (rdtsc on x86, clock_gettime elsewhere) and
+ * recorded into a per-operation histogram. Operations nested in a timed one
+ * (such as the pop_front inside an overwriting push_back) are not timed.
+ */
+class OperationProfiler {
+public:
+	/**
+     * Set how many calls share one timed sample.
+     * @param every_n 1 to time every call.
+     * @throws std::invalid_argument if every_n is not positive.
+     */
+	static void set_sample_rate(int every_n);
+	static int sample_rate();
+
+	/**
+     * Get the histogram of an operation. Values are in ticks of now().
+     */
+	static LatencyHistogram& histogram(ProfiledOp op);
+
+	/**
+     * Print the histograms of all operations.
+     * @param out The stream to print to.
+     */
+	static void dump(std::ostream& out);
+
+	/**
+     * Remove all recorded values.
+     */
+	static void reset();
+
+	/**
+     * Read the timestamp used for profiling: CPU cycles on x86, nanoseconds elsewhere.
+     */
+	static std::uint64_t now();
+
+	/**
+     * Advance the calling thread's call counter of an operation.
+     * @return True if this call is due to be timed.
+     */
+	static bool should_sample(ProfiledOp op);
+};
+
+/**
+ * Times the enclosing scope if the calling thread is due for a sample.
+ */
+class ProfileScope {
+	ProfiledOp _op;			// Operation being timed
+	std::uint64_t _start;	// Start timestamp, 0 if this call is not sampled
+	bool _sampled;			// Whether this scope records a value
+
+	static thread_local bool active;
+
+public:
+	explicit ProfileScope(ProfiledOp op);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
@@ -0,0 +1,254 @@
+#include<algorithm>
+#include"Lazy_Erase_Buffer.h"
+
+
+LazyEraseBuffer::LazyEraseBuffer(size_type capacity) {
+	if (capacity < 0) {
+		CB_THROW(std::invalid_argument("Capacity must be non-negative"));
+	}
+	size_type words = (capacity + 63) / 64;
+	_data.resize(capacity);
+	_live.assign(words, 0);
+	_tree.assign(words + 1, 0);
+	_capacity = capacity;
+	_head = 0;
+	_slots = 0;
+	_size = 0;
+	_threshold = default_threshold;
+}
+
+size_type LazyEraseBuffer::physical(size_type slot) const {
+	size_type p = _head + slot;
+	return p < _capacity ? p : p - _capacity;
+}
+
+bool LazyEraseBuffer::is_live(size_type p) const {
+	return (_live[p >> 6] >> (p & 63)) & 1;
+}
+
+void LazyEraseBuffer::set_live(size_type p, bool live) {
+	std::uint64_t bit = std::uint64_t(1) << (p & 63);
+	size_type delta = live ? 1 : -1;
+	if (live) {
+		_live[p >> 6] |= bit;
+	} else {
+		_live[p >> 6] &= ~bit;
+	}
+	size_type words = static_cast<size_type>(_live.size());
+	for (size_type w = (p >> 6) + 1; w <= words; w += w & -w) {
+		_tree[w] += delta;
+	}
+}
+
+size_type LazyEraseBuffer::rank(size_type p) const {
+	// Live slots with physical index below p.
+	size_type count = 0;
+	for (size_type w = p >> 6; w > 0; w -= w & -w) {
+		count += _tree[w];
+	}
+	if ((p & 63) != 0) {
+		count += __builtin_popcountll(_live[p >> 6] & ((std::uint64_t(1) << (p & 63)) - 1));
+	}
+	return count;
+}
+
+size_type LazyEraseBuffer::select(size_type k) const {
+	// Physical index of the k-th live slot (0-based) in physical order.
+	size_type words = static_cast<size_type>(_live.size());
+	size_type step = 1;
+	while (step * 2 <= words) {
+		step *= 2;
+	}
+	size_type w = 0;
+	for (; step > 0; step /= 2) {
+		if (w + step <= words && _tree[w + step] <= k) {
+			w += step;
+			k -= _tree[w];
+		}
+	}
+	std::uint64_t bits = _live[w];
+	for (; k > 0; k--) {
+		bits &= bits - 1;
+	}
+	return w * 64 + __builtin_ctzll(bits);
+}
+
+size_type LazyEraseBuffer::locate(size_type i) const {
+	// Live slots before the head are the ones that wrapped around.
+	size_type wrapped = rank(_head);
+	size_type tail = _size - wrapped;
+	return i < tail ? select(wrapped + i) : select(i - tail);
+}
+
+void LazyEraseBuffer::trim() {
+	while (_slots > 0 && !is_live(_head)) {
+		_head = _head + 1 == _capacity ? 0 : _head + 1;
+		_slots--;
+	}
+	while (_slots > 0 && !is_live(physical(_slots - 1))) {
+		_slots--;
+	}
+	if (_slots == 0) {
+		_head = 0;
+	}
+}
+
+void LazyEraseBuffer::rebuild_tree() {
+	size_type words = static_cast<size_type>(_live.size());
+	std::fill(_tree.begin(), _tree.end(), 0);
+	for (size_type w = 1; w <= words; w++) {
+		_tree[w] += __builtin_popcountll(_live[w - 1]);
+		size_type parent = w + (w & -w);
+		if (parent <= words) {
+			_tree[parent] += _tree[w];
+		}
+	}
+}
+
+value_type& LazyEraseBuffer::operator[](size_type i) {
+	return _data[locate(i)];
+}
+
+const value_type& LazyEraseBuffer::operator[](size_type i) const {
+	return _data[locate(i)];
+}
+
+value_type& LazyEraseBuffer::at(size_type i) {
+	if (i < 0 || i >= _size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return _data[locate(i)];
+}
+
+const value_type& LazyEraseBuffer::at(size_type i) const {
+	if (i < 0 || i >= _size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return _data[locate(i)];
+}
+
+value_type& LazyEraseBuffer::front() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _data[_head];
+}
+
+value_type& LazyEraseBuffer::back() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _data[physical(_slots - 1)];
+}
+
+void LazyEraseBuffer::push_back(const value_type& item) {
+	if (_capacity == 0) {
+		CB_THROW(std::out_of_range("Buffer has zero capacity"));
+	}
+	if (_slots == _capacity) {
+		if (full()) {
+			pop_front();
+		} else {
+			compact();
+		}
+	}
+	size_type p = physical(_slots);
+	_data[p] = item;
+	set_live(p, true);
+	_slots++;
+	_size++;
+}
+
+void LazyEraseBuffer::pop_front() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	set_live(_head, false);
+	_size--;
+	trim();
+}
+
+void LazyEraseBuffer::pop_back() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	set_live(physical(_slots - 1), false);
+	_size--;
+	trim();
+}
+
+void LazyEraseBuffer::erase(size_type first, size_type last) {
+	if (first >= last || first < 0 || last > _size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	size_type p = locate(first);
+	size_type slot = p >= _head ? p - _head : p + _capacity - _head;
+	for (size_type count = last - first; count > 0; slot++) {
+		p = physical(slot);
+		if (is_live(p)) {
+			set_live(p, false);
+			count--;
+		}
+	}
+	_size -= last - first;
+	trim();
+	if (dead() > _threshold * _slots) {
+		compact();
+	}
+}
+
+void LazyEraseBuffer::compact() {
+	if (dead() == 0) {
+		return;
+	}
+	// Rotate the slots to start at index 0, then slide live elements down in
+	// place. The bitmap is still indexed by the old physical positions.
+	std::rotate(_data.begin(), _data.begin() + _head, _data.end());
+	size_type write = 0;
+	for (size_type slot = 0; slot < _slots; slot++) {
+		if (is_live(physical(slot))) {
+			_data[write++] = _data[slot];
+		}
+	}
+	std::fill(_live.begin(), _live.end(), 0);
+	for (size_type w = 0; w < _size / 64; w++) {
+		_live[w] = ~std::uint64_t(0);
+	}
+	if (_size % 64 != 0) {
+		_live[_size / 64] = (std::uint64_t(1) << (_size % 64)) - 1;
+	}
+	rebuild_tree();
+	_head = 0;
+	_slots = _size;
+}
+
+void LazyEraseBuffer::set_compaction_threshold(double threshold) {
+	if (!(threshold > 0.0 && threshold <= 1.0)) {
+		CB_THROW(std::invalid_argument("Threshold must be in (0, 1]"));
+	}
+	_threshold = threshold;
+}
+
+size_type LazyEraseBuffer::size() const {
+	return _size;
+}
+
+bool LazyEraseBuffer::empty() const {
+	return _size == 0;
+}
+
+bool LazyEraseBuffer::full() const {
+	return _size == _capacity;
+}
+
+size_type LazyEraseBuffer::capacity() const {
+	return _capacity;
+}
+
+size_type LazyEraseBuffer::slots() const {
+	return _slots;
+}
+
+size_type LazyEraseBuffer::dead() const {
+	return _slots - _size;
+}
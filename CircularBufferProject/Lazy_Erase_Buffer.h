@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Circular buffer whose erase() only marks elements dead. Slots between the
+ * first and the last live element stay allocated, and a live bitmap says
+ * which of them hold elements. A Fenwick tree over the popcounts of the
+ * bitmap words gives rank/select, so operator[] finds the i-th live element
+ * in O(log n) instead of shifting the tail on every erase. Dead slots at
+ * either end are reclaimed as soon as they are uncovered by push/pop/erase,
+ * and the whole ring is compacted once the share of dead slots exceeds the
+ * compaction threshold or a push needs a slot while tombstones are present.
+ */
+class LazyEraseBuffer {
+	std::vector<value_type> _data;		// Slot storage
+	std::vector<std::uint64_t> _live;	// Bit per slot, set if the slot holds a live element
+	std::vector<size_type> _tree;		// Fenwick tree over the popcounts of _live words, 1-based
+	size_type _capacity;				// Maximum number of live elements
+	size_type _head;					// Physical index of the first slot in use
+	size_type _slots;					// Slots in use, live or dead
+	size_type _size;					// Number of live elements
+	double _threshold;					// Dead share of the slots that triggers compaction
+
+	size_type physical(size_type slot) const;
+	bool is_live(size_type p) const;
+	void set_live(size_type p, bool live);
+	size_type rank(size_type p) const;
+	size_type select(size_type k) const;
+	size_type locate(size_type i) const;
+	void trim();
+	void rebuild_tree();
+
+public:
+	static constexpr double default_threshold = 0.5;
+
+	/**
+     * Constructor to initialize an empty buffer.
+     * @param capacity Maximum number of live elements.
+     * @throws std::invalid_argument if the capacity is negative.
+     */
+	explicit LazyEraseBuffer(size_type capacity);
+
+	/**
+     * Access the i-th live element without bounds checking, in O(log n).
+     */
+	value_type& operator[](size_type i);
+	const value_type& operator[](size_type i) const;
+
+	/**
+     * Access the i-th live element with bounds checking.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	value_type& at(size_type i);
+	const value_type& at(size_type i) const;
+
+	/**
+     * Get a reference to the first or the last live element.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	value_type& front();
+	value_type& back();
+
+	/**
+     * Add an element to the end of the buffer.
+     * If the buffer is full, the first element is overwritten; if only the
+     * slots are exhausted by tombstones, the buffer is compacted first.
+     * @throws std::out_of_range if the capacity is zero.
+     */
+	void push_back(const value_type& item = value_type());
+
+	/**
+     * Remove the first or the last live element.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	void pop_front();
+	void pop_back();
+
+	/**
+     * Mark a range of live elements dead. Runs in O(log n) plus the number of
+     * slots walked, without moving any element.
+     * @param first The start of the range to remove (inclusive).
+     * @param last The end of the range to remove (exclusive).
+     * @throws std::out_of_range if the range is invalid.
+     */
+	void erase(size_type first, size_type last);
+
+	/**
+     * Move the live elements to the start of the storage and drop all tombstones.
+     */
+	void compact();
+
+	/**
+     * Call f(value_type&) for every live element in order, skipping tombstones.
+     */
+	template <typename Function>
+	void for_each(Function f);
+
+	/**
+     * Set the dead share of the slots in use above which erase() compacts.
+     * @throws std::invalid_argument if the threshold is not in (0, 1].
+     */
+	void set_compaction_threshold(double threshold);
+
+	size_type size() const;
+	bool empty() const;
+	bool full() const;
+	size_type capacity() const;
+
+	/**
+     * Get the number of slots in use and how many of them are tombstones.
+     */
+	size_type slots() const;
+	size_type dead() const;
+};
+
+template <typename Function>
+void LazyEraseBuffer::for_each(Function f) {
+	for (size_type slot = 0; slot < _slots; slot++) {
+		size_type p = physical(slot);
+		if (is_live(p)) {
+			f(_data[p]);
+		}
+	}
+}
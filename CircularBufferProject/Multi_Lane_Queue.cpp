@@ -0,0 +1,133 @@
+#include<algorithm>
+#include"Multi_Lane_Queue.h"
+
+
+MultiLaneQueue::MultiLaneQueue(int lanes, int lane_capacity, LanePolicy policy) {
+	if (lanes < 1 || lanes > max_lanes) {
+		CB_THROW(std::invalid_argument("Number of lanes must be from 1 to 64"));
+	}
+	_lanes.reserve(lanes);
+	for (int i = 0; i < lanes; i++) {
+		_lanes.emplace_back(lane_capacity);
+	}
+	_weights.assign(lanes, 1);
+	_deficits.assign(lanes, 0);
+	_occupied = 0;
+	_policy = policy;
+	_cursor = 0;
+	_in_turn = false;
+}
+
+void MultiLaneQueue::set_weight(int lane, int weight) {
+	if (lane < 0 || lane >= lanes()) {
+		CB_THROW(std::out_of_range("Lane does not exist"));
+	}
+	if (weight <= 0) {
+		CB_THROW(std::invalid_argument("Weight must be positive"));
+	}
+	_weights[lane] = weight;
+}
+
+int MultiLaneQueue::weight(int lane) const {
+	if (lane < 0 || lane >= lanes()) {
+		CB_THROW(std::out_of_range("Lane does not exist"));
+	}
+	return _weights[lane];
+}
+
+void MultiLaneQueue::push(int lane, const value_type& item) {
+	if (lane < 0 || lane >= lanes()) {
+		CB_THROW(std::out_of_range("Lane does not exist"));
+	}
+	_lanes[lane].push_back(item);
+	_occupied |= 1ull << lane;
+}
+
+bool MultiLaneQueue::try_push(int lane, const value_type& item) {
+	if (lane < 0 || lane >= lanes()) {
+		CB_THROW(std::out_of_range("Lane does not exist"));
+	}
+	if (_lanes[lane].full()) {
+		return false;
+	}
+	push(lane, item);
+	return true;
+}
+
+int MultiLaneQueue::next_lane() const {
+	std::uint64_t ahead = _cursor < max_lanes ? _occupied & (~0ull << _cursor) : 0;
+	return __builtin_ctzll(ahead != 0 ? ahead : _occupied);
+}
+
+void MultiLaneQueue::take(int lane, int n, value_type* out, int* lanes_out) {
+	CircularBuffer& ring = _lanes[lane];
+	ring.consume(n, [&out](const value_type* data, int count) {
+		out = std::copy(data, data + count, out);
+	});
+	if (lanes_out != nullptr) {
+		std::fill(lanes_out, lanes_out + n, lane);
+	}
+	if (ring.empty()) {
+		_occupied &= ~(1ull << lane);
+	}
+}
+
+int MultiLaneQueue::pop_batch(value_type* out, int max_n, int* lanes_out) {
+	int done = 0;
+	while (done < max_n && _occupied != 0) {
+		if (_policy == LanePolicy::StrictPriority) {
+			int lane = __builtin_ctzll(_occupied);
+			int n = static_cast<int>(std::min<size_type>(max_n - done, _lanes[lane].size()));
+			take(lane, n, out + done, lanes_out ? lanes_out + done : nullptr);
+			done += n;
+			continue;
+		}
+
+		int lane = next_lane();
+		if (lane != _cursor || !_in_turn) {
+			_cursor = lane;
+			_deficits[lane] += _weights[lane];
+			_in_turn = true;
+		}
+		int n = static_cast<int>(std::min<size_type>({max_n - done, _lanes[lane].size(), _deficits[lane]}));
+		take(lane, n, out + done, lanes_out ? lanes_out + done : nullptr);
+		done += n;
+		_deficits[lane] -= n;
+
+		if (_lanes[lane].empty()) {
+			_deficits[lane] = 0;
+		}
+		if (_lanes[lane].empty() || _deficits[lane] == 0) {
+			_cursor = lane + 1;
+			_in_turn = false;
+		}
+	}
+	return done;
+}
+
+size_type MultiLaneQueue::size(int lane) const {
+	if (lane < 0 || lane >= lanes()) {
+		CB_THROW(std::out_of_range("Lane does not exist"));
+	}
+	return _lanes[lane].size();
+}
+
+size_type MultiLaneQueue::size() const {
+	size_type total = 0;
+	for (const CircularBuffer& ring : _lanes) {
+		total += ring.size();
+	}
+	return total;
+}
+
+bool MultiLaneQueue::empty() const {
+	return _occupied == 0;
+}
+
+int MultiLaneQueue::lanes() const {
+	return static_cast<int>(_lanes.size());
+}
+
+std::uint64_t MultiLaneQueue::occupancy() const {
+	return _occupied;
+}
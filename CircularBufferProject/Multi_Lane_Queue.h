@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * How MultiLaneQueue chooses the lane to serve.
+ */
+enum class LanePolicy {
+	StrictPriority,		// Always serve the lowest-numbered non-empty lane
+	DeficitRoundRobin	// Serve lanes in turn, each up to its weight per round
+};
+
+/**
+ * Queue made of several CircularBuffer lanes, for example control,
+ * interactive and bulk traffic. pop_batch() fills a batch from the lanes in
+ * one pass according to the policy; with deficit round robin every lane gets
+ * a share proportional to its weight, so low-weight lanes are never starved.
+ * Non-empty lanes are tracked in a bitmask, so empty lanes are skipped in O(1).
+ */
+class MultiLaneQueue {
+	std::vector<CircularBuffer> _lanes;	// One ring per lane
+	std::vector<int> _weights;			// Elements served per round, per lane
+	std::vector<int> _deficits;			// Unused share of the current round, per lane
+	std::uint64_t _occupied;			// Bit i is set if lane i is not empty
+	LanePolicy _policy;					// Serving policy
+	int _cursor;						// Lane whose round-robin turn comes next
+	bool _in_turn;						// Whether the turn of _cursor already received its quantum
+
+	int next_lane() const;
+	void take(int lane, int n, value_type* out, int* lanes_out);
+
+public:
+	static const int max_lanes = 64;
+
+	/**
+     * Constructor to initialize a queue with equal lanes of weight 1.
+     * @param lanes Number of lanes, from 1 to max_lanes.
+     * @param lane_capacity Capacity of every lane.
+     * @param policy How lanes are chosen in pop_batch().
+     * @throws std::invalid_argument if the number of lanes is out of range.
+     */
+	MultiLaneQueue(int lanes, int lane_capacity, LanePolicy policy = LanePolicy::DeficitRoundRobin);
+
+	/**
+     * Set the number of elements a lane may deliver per round robin round.
+     * @throws std::out_of_range if the lane does not exist.
+     * @throws std::invalid_argument if the weight is not positive.
+     */
+	void set_weight(int lane, int weight);
+
+	/**
+     * Get the weight of a lane.
+     * @throws std::out_of_range if the lane does not exist.
+     */
+	int weight(int lane) const;
+
+	/**
+     * Add an element to a lane. If the lane is full, its oldest element is overwritten.
+     * @throws std::out_of_range if the lane does not exist.
+     */
+	void push(int lane, const value_type& item);
+
+	/**
+     * Add an element to a lane unless it is full.
+     * @return True if the element was added, false if the lane is full.
+     * @throws std::out_of_range if the lane does not exist.
+     */
+	bool try_push(int lane, const value_type& item);
+
+	/**
+     * Remove up to max_n elements in one pass over the lanes.
+     * @param out Destination for the elements.
+     * @param max_n Maximum number of elements to remove.
+     * @param lanes_out Optional destination for the lane of every element.
+     * @return Number of elements removed.
+     */
+	int pop_batch(value_type* out, int max_n, int* lanes_out = nullptr);
+
+	/**
+     * Get the number of elements in one lane or in all lanes.
+     * @throws std::out_of_range if the lane does not exist.
+     */
+	size_type size(int lane) const;
+	size_type size() const;
+	bool empty() const;
+	int lanes() const;
+
+	/**
+     * Get the bitmask of non-empty lanes.
+     */
+	std::uint64_t occupancy() const;
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Parallel algorithms over the contents of a CircularBuffer.
+ * The logical range is cut into equal chunks, one per thread; a chunk that
+ * crosses the wrap point is processed as two contiguous pieces by the same
+ * thread, so the callbacks always see plain pointer ranges. Reductions combine
+ * the per-chunk results in logical order, so the operation must be
+ * associative but need not be commutative.
+ */
+
+/**
+ * Minimum number of elements per thread; smaller inputs use fewer threads.
+ */
+const int parallel_grain_size = 1 << 14;
+
+namespace parallel_detail {
+
+inline int thread_count(size_type n, int threads) {
+	if (threads <= 0) {
+		threads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	size_type by_grain = (n + parallel_grain_size - 1) / parallel_grain_size;
+	return static_cast<int>(std::max<size_type>(1, std::min<size_type>(threads, by_grain)));
+}
+
+// Calls body(chunk, first, last) for the pieces of every chunk, each chunk on its own thread.
+template <typename T, typename Body>
+void run_chunks(const SegmentPair<T>& segments, int chunks, Body body) {
+	const size_type n = segments.size();
+	auto run = [&](int chunk) {
+		size_type begin = n / chunks * chunk + n % chunks * chunk / chunks;
+		size_type end = n / chunks * (chunk + 1) + n % chunks * (chunk + 1) / chunks;
+		size_type split = segments.first.size;
+		if (begin < split) {
+			body(chunk, segments.first.data + begin, segments.first.data + std::min(end, split));
+		}
+		if (end > split) {
+			body(chunk, segments.second.data + std::max(begin, split) - split, segments.second.data + end - split);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(chunks - 1);
+	for (int chunk = 1; chunk < chunks; chunk++) {
+		workers.emplace_back(run, chunk);
+	}
+	run(0);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+}
+
+/**
+ * Apply a function to every element of the buffer in parallel.
+ * @param cb The buffer to process.
+ * @param f Callable taking value_type&.
+ * @param threads Number of threads, 0 for all hardware threads.
+ */
+template <typename Function>
+void parallel_for_each(CircularBuffer& cb, Function f, int threads = 0) {
+	SegmentPair<value_type> segments = cb.segments();
+	int chunks = parallel_detail::thread_count(segments.size(), threads);
+	parallel_detail::run_chunks(segments, chunks, [&f](int, value_type* first, value_type* last) {
+		std::for_each(first, last, f);
+	});
+}
+
+/**
+ * Transform every element and reduce the results in parallel.
+ * @param cb The buffer to process.
+ * @param init Initial value, combined once with the result.
+ * @param reduce Associative binary operation on T.
+ * @param transform Callable mapping const value_type& to T.
+ * @param threads Number of threads, 0 for all hardware threads.
+ * @return reduce(init, transform(cb[0]), ..., transform(cb[size - 1])) in logical order.
+ */
+template <typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(const CircularBuffer& cb, T init, Reduce reduce, Transform transform, int threads = 0) {
+	SegmentPair<const value_type> segments = cb.segments();
+	if (segments.empty()) {
+		return init;
+	}
+	int chunks = parallel_detail::thread_count(segments.size(), threads);
+	std::vector<T> partial(chunks);
+	std::vector<char> started(chunks, 0);
+	parallel_detail::run_chunks(segments, chunks, [&](int chunk, const value_type* first, const value_type* last) {
+		T acc = started[chunk] ? partial[chunk] : transform(*first++);
+		for (; first != last; ++first) {
+			acc = reduce(acc, transform(*first));
+		}
+		partial[chunk] = acc;
+		started[chunk] = 1;
+	});
+	for (int chunk = 0; chunk < chunks; chunk++) {
+		init = reduce(init, partial[chunk]);
+	}
+	return init;
+}
+
+/**
+ * Reduce the elements in parallel.
+ * @param cb The buffer to process.
+ * @param init Initial value, combined once with the result.
+ * @param reduce Associative binary operation, std::plus by default.
+ * @param threads Number of threads, 0 for all hardware threads.
+ */
+template <typename T, typename Reduce = std::plus<T>>
+T parallel_reduce(const CircularBuffer& cb, T init, Reduce reduce = Reduce(), int threads = 0) {
+	return parallel_transform_reduce(cb, init, reduce, [](const value_type& v) { return static_cast<T>(v); }, threads);
+}
+
+/**
+ * Sort the buffer in place in parallel.
+ * The buffer is linearized first, then chunks are sorted concurrently and
+ * merged pairwise, each merge round running in parallel.
+ * @param cb The buffer to sort.
+ * @param comp Strict weak ordering, std::less by default.
+ * @param threads Number of threads, 0 for all hardware threads.
+ */
+template <typename Compare = std::less<value_type>>
+void parallel_sort(CircularBuffer& cb, Compare comp = Compare(), int threads = 0) {
+	const size_type n = cb.size();
+	value_type* data = cb.linearize();
+	int chunks = parallel_detail::thread_count(n, threads);
+
+	std::vector<size_type> bounds(chunks + 1);
+	for (int chunk = 0; chunk <= chunks; chunk++) {
+		bounds[chunk] = n / chunks * chunk + n % chunks * chunk / chunks;
+	}
+
+	SegmentPair<value_type> whole = cb.segments();
+	parallel_detail::run_chunks(whole, chunks, [&comp](int, value_type* first, value_type* last) {
+		std::sort(first, last, comp);
+	});
+
+	for (int width = 1; width < chunks; width *= 2) {
+		std::vector<std::thread> workers;
+		for (int left = 0; left + width < chunks; left += 2 * width) {
+			size_type mid = bounds[left + width];
+			size_type right = bounds[std::min(left + 2 * width, chunks)];
+			size_type begin = bounds[left];
+			workers.emplace_back([data, begin, mid, right, &comp]() {
+				std::inplace_merge(data + begin, data + mid, data + right, comp);
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+}
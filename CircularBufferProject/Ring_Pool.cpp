@@ -0,0 +1,157 @@
+#include<algorithm>
+#include"Ring_Pool.h"
+
+
+RingPool::RingPool() {
+	_rings = 0;
+}
+
+int RingPool::size_class(RingHandle h) {
+	return static_cast<int>(h.slot >> 28);
+}
+
+std::uint32_t RingPool::offset(RingHandle h) {
+	return h.slot & (max_slab - 1);
+}
+
+void RingPool::check(RingHandle h) {
+	if (!h.valid()) {
+		CB_THROW(std::invalid_argument("Null ring handle"));
+	}
+}
+
+int RingPool::physical(RingHandle h, int i) {
+	return static_cast<int>(offset(h)) + ((h.head + i) & (capacity(h) - 1));
+}
+
+RingHandle RingPool::create(int capacity) {
+	if (capacity < 1 || capacity > max_capacity) {
+		CB_THROW(std::invalid_argument("Ring capacity must be from 1 to 32768"));
+	}
+	int cls = 0;
+	while ((1 << cls) < capacity) {
+		cls++;
+	}
+	std::uint32_t at;
+	if (!_free[cls].empty()) {
+		at = _free[cls].back();
+		_free[cls].pop_back();
+	} else {
+		std::size_t used = _slab.size();
+		if (used + (std::size_t(1) << cls) > max_slab) {
+			CB_THROW(std::length_error("Ring pool slab is exhausted"));
+		}
+		at = static_cast<std::uint32_t>(used);
+		_slab.resize(used + (std::size_t(1) << cls));
+	}
+	_rings++;
+	RingHandle h;
+	h.slot = (static_cast<std::uint32_t>(cls) << 28) | at;
+	h.head = 0;
+	h.size = 0;
+	return h;
+}
+
+void RingPool::destroy(RingHandle& h) {
+	check(h);
+	_free[size_class(h)].push_back(offset(h));
+	_rings--;
+	h = RingHandle();
+}
+
+void RingPool::push_back(RingHandle& h, const value_type& item) {
+	check(h);
+	if (full(h)) {
+		_slab[physical(h, 0)] = item;
+		h.head = static_cast<std::uint16_t>((h.head + 1) & (capacity(h) - 1));
+		return;
+	}
+	_slab[physical(h, h.size)] = item;
+	h.size++;
+}
+
+void RingPool::pop_front(RingHandle& h) {
+	check(h);
+	if (empty(h)) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	h.head = static_cast<std::uint16_t>((h.head + 1) & (capacity(h) - 1));
+	h.size--;
+}
+
+void RingPool::pop_back(RingHandle& h) {
+	check(h);
+	if (empty(h)) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	h.size--;
+}
+
+value_type& RingPool::at(RingHandle h, int i) {
+	check(h);
+	if (i < 0 || i >= h.size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return _slab[physical(h, i)];
+}
+
+const value_type& RingPool::at(RingHandle h, int i) const {
+	check(h);
+	if (i < 0 || i >= h.size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return _slab[physical(h, i)];
+}
+
+value_type& RingPool::front(RingHandle h) {
+	check(h);
+	if (empty(h)) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _slab[physical(h, 0)];
+}
+
+value_type& RingPool::back(RingHandle h) {
+	check(h);
+	if (empty(h)) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _slab[physical(h, h.size - 1)];
+}
+
+SegmentPair<value_type> RingPool::segments(RingHandle h) {
+	check(h);
+	value_type* base = _slab.data() + offset(h);
+	int first_len = std::min<int>(h.size, capacity(h) - h.head);
+	SegmentPair<value_type> result;
+	result.first.data = base + h.head;
+	result.first.size = first_len;
+	result.second.data = base;
+	result.second.size = h.size - first_len;
+	return result;
+}
+
+int RingPool::capacity(RingHandle h) {
+	check(h);
+	return 1 << size_class(h);
+}
+
+int RingPool::size(RingHandle h) {
+	return h.size;
+}
+
+bool RingPool::empty(RingHandle h) {
+	return h.size == 0;
+}
+
+bool RingPool::full(RingHandle h) {
+	return h.size == capacity(h);
+}
+
+int RingPool::rings() const {
+	return _rings;
+}
+
+std::size_t RingPool::memory_bytes() const {
+	return _slab.capacity() * sizeof(value_type);
+}
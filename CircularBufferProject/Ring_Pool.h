@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Compact reference to a ring allocated from a RingPool, 8 bytes in total.
+ * The capacity is a power of two, so it is stored as a 4-bit size class next
+ * to the slab offset; there is no end index or full flag, both follow from
+ * head and size. Handles hold offsets rather than pointers and stay valid
+ * when the slab grows. A default-constructed handle is null and refers to
+ * no ring; RingPool rejects it.
+ */
+struct RingHandle {
+	static constexpr std::uint32_t null_slot = 0xFFFFFFFFu;	// Never a valid slot: no ring fits at that offset
+
+	std::uint32_t slot = null_slot;	// Size class in the top 4 bits, slab offset in the lower 28
+	std::uint16_t head = 0;			// Index of the first element within the ring
+	std::uint16_t size = 0;			// Number of elements in the ring
+
+	bool valid() const { return slot != null_slot; }
+};
+
+static_assert(sizeof(RingHandle) == 8, "RingHandle must stay 8 bytes");
+
+/**
+ * Arena for many small rings, such as one per connection. Ring storage is
+ * carved from a single slab by power-of-two size class and recycled through
+ * per-class free lists, so rings created together sit next to each other in
+ * memory and the per-ring overhead is the 8-byte RingHandle. The pool owns
+ * the storage; handles are passed to its members, which mirror the
+ * CircularBuffer API. Capacities go up to max_capacity. Passing a null
+ * handle throws std::invalid_argument; a copy of a handle that was destroyed
+ * through another copy cannot be detected and must not be used.
+ */
+class RingPool {
+	std::vector<value_type> _slab;				// Storage of all rings
+	std::vector<std::uint32_t> _free[16];		// Offsets of released rings, per size class
+	int _rings;									// Number of live rings
+
+	static int size_class(RingHandle h);
+	static std::uint32_t offset(RingHandle h);
+	static int physical(RingHandle h, int i);
+	static void check(RingHandle h);
+
+public:
+	static constexpr int max_capacity = 1 << 15;
+	static constexpr std::uint32_t max_slab = 1u << 28;
+
+	RingPool();
+
+	/**
+     * Allocate an empty ring.
+     * @param capacity Minimum capacity, rounded up to a power of two.
+     * @return Handle to the new ring.
+     * @throws std::invalid_argument if the capacity is not in [1, max_capacity].
+     * @throws std::length_error if the slab would exceed max_slab elements.
+     */
+	RingHandle create(int capacity);
+
+	/**
+     * Return the storage of a ring to the pool and reset the handle to null.
+     * @throws std::invalid_argument if the handle is null, e.g. already destroyed.
+     */
+	void destroy(RingHandle& h);
+
+	/**
+     * Add an element to the end of a ring.
+     * If the ring is full, the first element is overwritten.
+     */
+	void push_back(RingHandle& h, const value_type& item);
+
+	/**
+     * Remove the first or the last element of a ring.
+     * @throws std::out_of_range if the ring is empty.
+     */
+	void pop_front(RingHandle& h);
+	void pop_back(RingHandle& h);
+
+	/**
+     * Access an element of a ring by index with bounds checking.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	value_type& at(RingHandle h, int i);
+	const value_type& at(RingHandle h, int i) const;
+
+	/**
+     * Get a reference to the first or the last element of a ring.
+     * @throws std::out_of_range if the ring is empty.
+     */
+	value_type& front(RingHandle h);
+	value_type& back(RingHandle h);
+
+	/**
+     * Get the elements of a ring as at most two contiguous segments.
+     * @return Views in logical order, valid until the next modification of the pool.
+     */
+	SegmentPair<value_type> segments(RingHandle h);
+
+	static int capacity(RingHandle h);
+	static int size(RingHandle h);
+	static bool empty(RingHandle h);
+	static bool full(RingHandle h);
+
+	/**
+     * Get the number of live rings.
+     */
+	int rings() const;
+
+	/**
+     * Get the size of the slab in bytes, including released rings.
+     */
+	std::size_t memory_bytes() const;
+};
@@ -0,0 +1,202 @@
+#include<algorithm>
+#include"Segmented_Queue.h"
+
+
+SegmentedQueue::SegmentedQueue(int chunk_size) {
+	if (chunk_size <= 0 || (chunk_size & (chunk_size - 1)) != 0) {
+		CB_THROW(std::invalid_argument("Chunk size must be a positive power of two"));
+	}
+	_chunk_shift = 0;
+	while ((1 << _chunk_shift) < chunk_size) {
+		_chunk_shift++;
+	}
+	_map_head = 0;
+	_chunks = 0;
+	_head_offset = 0;
+	_size = 0;
+}
+
+SegmentedQueue::~SegmentedQueue() {
+	clear();
+	shrink_to_fit();
+}
+
+value_type* SegmentedQueue::acquire_chunk() {
+	if (_spare.empty()) {
+		return new value_type[chunk_size()];
+	}
+	value_type* chunk = _spare.back();
+	_spare.pop_back();
+	return chunk;
+}
+
+void SegmentedQueue::release_chunk(value_type* chunk) {
+	if (static_cast<int>(_spare.size()) < max_spare_chunks) {
+		_spare.push_back(chunk);
+	} else {
+		delete[] chunk;
+	}
+}
+
+void SegmentedQueue::grow_map() {
+	std::vector<value_type*> map(std::max<std::size_t>(4, _map.size() * 2));
+	for (int i = 0; i < _chunks; i++) {
+		map[i] = chunk(i);
+	}
+	_map.swap(map);
+	_map_head = 0;
+}
+
+value_type*& SegmentedQueue::chunk(int i) {
+	int idx = _map_head + i;
+	int map_size = static_cast<int>(_map.size());
+	return _map[idx < map_size ? idx : idx - map_size];
+}
+
+value_type& SegmentedQueue::element(int i) const {
+	int pos = _head_offset + i;
+	int idx = _map_head + (pos >> _chunk_shift);
+	int map_size = static_cast<int>(_map.size());
+	return _map[idx < map_size ? idx : idx - map_size][pos & (chunk_size() - 1)];
+}
+
+void SegmentedQueue::push_back(const value_type& item) {
+	int pos = _head_offset + _size;
+	if ((pos >> _chunk_shift) == _chunks) {
+		if (_chunks == static_cast<int>(_map.size())) {
+			grow_map();
+		}
+		chunk(_chunks) = acquire_chunk();
+		_chunks++;
+	}
+	_size++;
+	element(_size - 1) = item;
+}
+
+void SegmentedQueue::push_front(const value_type& item) {
+	if (_head_offset == 0) {
+		if (_chunks == static_cast<int>(_map.size())) {
+			grow_map();
+		}
+		// Allocate before moving the map head, so a bad_alloc leaves the queue intact.
+		value_type* fresh = acquire_chunk();
+		int map_size = static_cast<int>(_map.size());
+		_map_head = _map_head == 0 ? map_size - 1 : _map_head - 1;
+		_map[_map_head] = fresh;
+		_chunks++;
+		_head_offset = chunk_size();
+	}
+	_head_offset--;
+	_size++;
+	element(0) = item;
+}
+
+void SegmentedQueue::pop_front() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	_head_offset++;
+	_size--;
+	if (_head_offset == chunk_size() || _size == 0) {
+		release_chunk(chunk(0));
+		_map_head = _map_head + 1 == static_cast<int>(_map.size()) ? 0 : _map_head + 1;
+		_chunks--;
+		_head_offset = 0;
+	}
+}
+
+void SegmentedQueue::pop_back() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	_size--;
+	int used = _size == 0 ? 0 : ((_head_offset + _size - 1) >> _chunk_shift) + 1;
+	if (used < _chunks) {
+		release_chunk(chunk(_chunks - 1));
+		_chunks--;
+	}
+	if (_size == 0) {
+		_head_offset = 0;
+	}
+}
+
+value_type& SegmentedQueue::operator[](int i) {
+	return element(i);
+}
+
+const value_type& SegmentedQueue::operator[](int i) const {
+	return element(i);
+}
+
+value_type& SegmentedQueue::at(int i) {
+	if (i < 0 || i >= _size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return element(i);
+}
+
+const value_type& SegmentedQueue::at(int i) const {
+	if (i < 0 || i >= _size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	return element(i);
+}
+
+value_type& SegmentedQueue::front() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return element(0);
+}
+
+value_type& SegmentedQueue::back() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return element(_size - 1);
+}
+
+int SegmentedQueue::size() const {
+	return _size;
+}
+
+bool SegmentedQueue::empty() const {
+	return _size == 0;
+}
+
+int SegmentedQueue::chunk_size() const {
+	return 1 << _chunk_shift;
+}
+
+int SegmentedQueue::chunks() const {
+	return _chunks;
+}
+
+int SegmentedQueue::spare_chunks() const {
+	return static_cast<int>(_spare.size());
+}
+
+void SegmentedQueue::clear() {
+	for (int i = 0; i < _chunks; i++) {
+		release_chunk(chunk(i));
+	}
+	_map_head = 0;
+	_chunks = 0;
+	_head_offset = 0;
+	_size = 0;
+}
+
+void SegmentedQueue::shrink_to_fit() {
+	for (value_type* chunk : _spare) {
+		delete[] chunk;
+	}
+	_spare.clear();
+	_spare.shrink_to_fit();
+
+	std::vector<value_type*> map(_chunks);
+	for (int i = 0; i < _chunks; i++) {
+		map[i] = chunk(i);
+	}
+	_map.swap(map);
+	_map_head = 0;
+}
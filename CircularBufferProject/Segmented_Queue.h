@@ -0,0 +1,99 @@
+#pragma once
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Unbounded double-ended queue built from fixed-size chunks. The chunk
+ * pointers form a ring map; growing at either end links one more chunk and
+ * shrinking hands the chunk back to a free list, so elements are never
+ * copied and push/pop stay O(1) at both ends. Only the map of pointers is
+ * reallocated when it fills up, which copies one pointer per chunk.
+ * Memory follows the occupancy: at most one partly used chunk per end plus
+ * up to max_spare_chunks kept for reuse, so a queue that oscillates around a
+ * chunk boundary does not hit the allocator; the rest is freed at once.
+ * shrink_to_fit() also returns the spare chunks and the unused map.
+ */
+class SegmentedQueue {
+	std::vector<value_type*> _map;		// Ring of chunk pointers
+	std::vector<value_type*> _spare;	// Free list of unused chunks, at most max_spare_chunks
+	int _map_head;						// Index in _map of the first chunk in use
+	int _chunks;						// Number of chunks in use
+	int _head_offset;					// Index of the first element within the first chunk
+	int _size;							// Current number of elements
+	int _chunk_shift;					// log2 of the chunk size
+
+	value_type* acquire_chunk();
+	void release_chunk(value_type* chunk);
+	void grow_map();
+	value_type*& chunk(int i);
+	value_type& element(int i) const;
+
+public:
+	static constexpr int default_chunk_size = 512;
+	static constexpr int max_spare_chunks = 2;
+
+	/**
+     * Constructor to initialize an empty queue.
+     * @param chunk_size Number of elements per chunk, a power of two.
+     * @throws std::invalid_argument if the chunk size is not a positive power of two.
+     */
+	explicit SegmentedQueue(int chunk_size = default_chunk_size);
+	~SegmentedQueue();
+
+	SegmentedQueue(const SegmentedQueue&) = delete;
+	SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+
+	/**
+     * Add an element to the end or to the front of the queue.
+     */
+	void push_back(const value_type& item = value_type());
+	void push_front(const value_type& item = value_type());
+
+	/**
+     * Remove the first or the last element of the queue.
+     * A chunk that becomes unused goes to the free list, or is freed if the list is full.
+     * @throws std::out_of_range if the queue is empty.
+     */
+	void pop_front();
+	void pop_back();
+
+	/**
+     * Access an element by index without bounds checking.
+     */
+	value_type& operator[](int i);
+	const value_type& operator[](int i) const;
+
+	/**
+     * Access an element by index with bounds checking.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	value_type& at(int i);
+	const value_type& at(int i) const;
+
+	/**
+     * Get a reference to the first or the last element.
+     * @throws std::out_of_range if the queue is empty.
+     */
+	value_type& front();
+	value_type& back();
+
+	int size() const;
+	bool empty() const;
+	int chunk_size() const;
+
+	/**
+     * Get the number of chunks holding elements and the number of chunks in the free list.
+     */
+	int chunks() const;
+	int spare_chunks() const;
+
+	/**
+     * Remove all elements; up to max_spare_chunks of their chunks go to the free list.
+     */
+	void clear();
+
+	/**
+     * Free the chunks in the free list and shrink the map to the chunks in use.
+     */
+	void shrink_to_fit();
+};
@@ -0,0 +1,65 @@
+#include<algorithm>
+#include<stdexcept>
+#include"Seqlock_Buffer.h"
+
+
+SeqlockBuffer::SeqlockBuffer(int capacity) {
+	if (capacity <= 0) {
+		CB_THROW(std::invalid_argument("Capacity must be positive"));
+	}
+	_slots.reset(new Slot[capacity]);
+	for (int i = 0; i < capacity; i++) {
+		_slots[i].seq.store(0, std::memory_order_relaxed);
+		_slots[i].value.store(value_type(), std::memory_order_relaxed);
+	}
+	_capacity = capacity;
+	_count.store(0, std::memory_order_release);
+}
+
+void SeqlockBuffer::push_back(const value_type& item) {
+	std::uint64_t p = _count.load(std::memory_order_relaxed);
+	Slot& slot = _slots[p % _capacity];
+	slot.seq.store(2 * p + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.value.store(item, std::memory_order_relaxed);
+	slot.seq.store(2 * p + 2, std::memory_order_release);
+	_count.store(p + 1, std::memory_order_release);
+}
+
+int SeqlockBuffer::snapshot(value_type* out, int n) const {
+	for (;;) {
+		std::uint64_t count = _count.load(std::memory_order_acquire);
+		std::uint64_t available = std::min<std::uint64_t>(count, _capacity);
+		int k = static_cast<int>(std::min<std::uint64_t>(available, n < 0 ? 0 : n));
+
+		bool consistent = true;
+		for (int i = 0; i < k; i++) {
+			std::uint64_t p = count - k + i;
+			const Slot& slot = _slots[p % _capacity];
+			std::uint64_t before = slot.seq.load(std::memory_order_acquire);
+			value_type value = slot.value.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			std::uint64_t after = slot.seq.load(std::memory_order_relaxed);
+			if (before != 2 * p + 2 || after != before) {
+				consistent = false;
+				break;
+			}
+			out[i] = value;
+		}
+		if (consistent) {
+			return k;
+		}
+	}
+}
+
+std::uint64_t SeqlockBuffer::pushed() const {
+	return _count.load(std::memory_order_acquire);
+}
+
+int SeqlockBuffer::size() const {
+	return static_cast<int>(std::min<std::uint64_t>(pushed(), _capacity));
+}
+
+int SeqlockBuffer::capacity() const {
+	return _capacity;
+}
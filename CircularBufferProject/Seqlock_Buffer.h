@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "Circular_Buffer.h"
+
+/**
+ * Lossy ring for one writer and any number of readers that want the most
+ * recent values. Every slot carries a sequence counter: the writer marks the
+ * slot odd while storing and even when done, readers copy optimistically and
+ * retry if a counter shows the slot was rewritten meanwhile. push_back is
+ * wait-free and never waits for readers; readers only load, they never lock
+ * or perform read-modify-write operations.
+ */
+class SeqlockBuffer {
+	struct Slot {
+		std::atomic<std::uint64_t> seq;		// 2p + 1 while push p is written, 2p + 2 when done
+		std::atomic<value_type> value;		// The element of the last completed push
+	};
+
+	std::unique_ptr<Slot[]> _slots;				// Slot storage
+	int _capacity;								// Total capacity of the buffer
+	alignas(64) std::atomic<std::uint64_t> _count;	// Number of completed pushes
+
+public:
+	/**
+     * Constructor to initialize a buffer with a specific capacity.
+     * @param capacity The number of most recent elements kept.
+     * @throws std::invalid_argument if the capacity is not positive.
+     */
+	explicit SeqlockBuffer(int capacity);
+
+	SeqlockBuffer(const SeqlockBuffer&) = delete;
+	SeqlockBuffer& operator=(const SeqlockBuffer&) = delete;
+
+	/**
+     * Add an element, overwriting the oldest one when full.
+     * Must only be called from the single writer thread. Wait-free.
+     * @param item The element to add.
+     */
+	void push_back(const value_type& item);
+
+	/**
+     * Copy a consistent snapshot of the most recent elements, oldest first.
+     * Safe to call from any thread concurrently with push_back. Retries while
+     * the writer overwrites the slots being copied, so n should stay well
+     * below capacity() if the writer is fast.
+     * @param out Destination for up to n elements.
+     * @param n Maximum number of elements to copy.
+     * @return Number of elements copied: min(n, size()) at the snapshot moment.
+     */
+	int snapshot(value_type* out, int n) const;
+
+	/**
+     * Get the total number of elements pushed so far.
+     */
+	std::uint64_t pushed() const;
+
+	/**
+     * Get the number of elements currently available to readers.
+     */
+	int size() const;
+
+	int capacity() const;
+};
@@ -0,0 +1,260 @@
+#include<algorithm>
+#include<cerrno>
+#include<new>
+#include<system_error>
+#include<fcntl.h>
+#include<sys/eventfd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#include"Shm_Ring_Buffer.h"
+
+namespace {
+
+const std::uint32_t shm_magic = 0x43425348;	// "CBSH"
+
+// The header is shared between processes, which only works for atomics
+// that do not fall back to a lock inside one process.
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "32-bit atomics must be lock-free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "64-bit atomics must be lock-free");
+
+void fail([[maybe_unused]] const char* what) {
+	CB_THROW(std::system_error(errno, std::generic_category(), what));
+}
+
+// Closes the descriptors handed to a constructor that is about to fail.
+void close_and_fail(int fd, int event_fd, const char* what) {
+	int saved = errno;
+	if (event_fd >= 0) {
+		close(event_fd);
+	}
+	close(fd);
+	errno = saved;
+	fail(what);
+}
+
+}
+
+
+std::size_t ShmRingBuffer::segment_size(std::uint64_t capacity) {
+	return sizeof(Header) + capacity * sizeof(value_type);
+}
+
+ShmRingBuffer::ShmRingBuffer(int fd, int event_fd, bool initialize, std::uint64_t capacity) {
+	_fd = fd;
+	_event_fd = event_fd;
+	_base = nullptr;
+	_bytes = 0;
+
+	if (!initialize) {
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			close_and_fail(fd, event_fd, "fstat");
+		}
+		if (static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+			errno = EINVAL;
+			close_and_fail(fd, event_fd, "Shared segment is too small");
+		}
+		_bytes = static_cast<std::size_t>(st.st_size);
+	} else {
+		_bytes = segment_size(capacity);
+		if (ftruncate(fd, static_cast<off_t>(_bytes)) != 0) {
+			close_and_fail(fd, event_fd, "ftruncate");
+		}
+	}
+
+	_base = mmap(nullptr, _bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (_base == MAP_FAILED) {
+		_base = nullptr;
+		close_and_fail(fd, event_fd, "mmap");
+	}
+
+	Header* h = header();
+	if (initialize) {
+		new (h) Header;
+		h->element_size = sizeof(value_type);
+		h->capacity = capacity;
+		h->data_offset = sizeof(Header);
+		h->head.store(0, std::memory_order_relaxed);
+		h->tail.store(0, std::memory_order_relaxed);
+		h->consumer_waiting.store(0, std::memory_order_relaxed);
+		h->magic.store(shm_magic, std::memory_order_release);
+	} else if (h->magic.load(std::memory_order_acquire) != shm_magic || h->element_size != sizeof(value_type)
+	           || h->data_offset != sizeof(Header) || h->capacity == 0
+	           || h->capacity > (_bytes - sizeof(Header)) / sizeof(value_type)) {
+		// The header comes from another process; everything read and write
+		// rely on is checked here, without computing sizes that could overflow.
+		munmap(_base, _bytes);
+		errno = EINVAL;
+		close_and_fail(fd, event_fd, "Shared segment is not a ShmRingBuffer");
+	}
+}
+
+ShmRingBuffer ShmRingBuffer::create(int capacity, bool notify) {
+	if (capacity <= 0) {
+		CB_THROW(std::invalid_argument("Capacity must be positive"));
+	}
+	int fd = memfd_create("circular_buffer", 0);
+	if (fd < 0) {
+		fail("memfd_create");
+	}
+	int efd = -1;
+	if (notify) {
+		efd = eventfd(0, 0);
+		if (efd < 0) {
+			close(fd);
+			fail("eventfd");
+		}
+	}
+	return ShmRingBuffer(fd, efd, true, static_cast<std::uint64_t>(capacity));
+}
+
+ShmRingBuffer ShmRingBuffer::create_named(const std::string& name, int capacity) {
+	if (capacity <= 0) {
+		CB_THROW(std::invalid_argument("Capacity must be positive"));
+	}
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0) {
+		fail("shm_open");
+	}
+	return ShmRingBuffer(fd, -1, true, static_cast<std::uint64_t>(capacity));
+}
+
+ShmRingBuffer ShmRingBuffer::open_named(const std::string& name) {
+	int fd = shm_open(name.c_str(), O_RDWR, 0600);
+	if (fd < 0) {
+		fail("shm_open");
+	}
+	return ShmRingBuffer(fd, -1, false, 0);
+}
+
+ShmRingBuffer ShmRingBuffer::attach(int fd, int event_fd) {
+	return ShmRingBuffer(fd, event_fd, false, 0);
+}
+
+void ShmRingBuffer::unlink(const std::string& name) {
+	shm_unlink(name.c_str());
+}
+
+ShmRingBuffer::ShmRingBuffer(ShmRingBuffer&& other) noexcept {
+	_fd = other._fd;
+	_event_fd = other._event_fd;
+	_base = other._base;
+	_bytes = other._bytes;
+	other._fd = -1;
+	other._event_fd = -1;
+	other._base = nullptr;
+	other._bytes = 0;
+}
+
+ShmRingBuffer& ShmRingBuffer::operator=(ShmRingBuffer&& other) noexcept {
+	if (this != &other) {
+		this->~ShmRingBuffer();
+		new (this) ShmRingBuffer(std::move(other));
+	}
+	return *this;
+}
+
+ShmRingBuffer::~ShmRingBuffer() {
+	if (_base != nullptr) {
+		munmap(_base, _bytes);
+	}
+	if (_event_fd >= 0) {
+		close(_event_fd);
+	}
+	if (_fd >= 0) {
+		close(_fd);
+	}
+}
+
+ShmRingBuffer::Header* ShmRingBuffer::header() const {
+	return static_cast<Header*>(_base);
+}
+
+value_type* ShmRingBuffer::data() const {
+	return reinterpret_cast<value_type*>(static_cast<char*>(_base) + header()->data_offset);
+}
+
+int ShmRingBuffer::write(const value_type* items, int n) {
+	Header* h = header();
+	const std::uint64_t cap = h->capacity;
+	std::uint64_t tail = h->tail.load(std::memory_order_relaxed);
+	std::uint64_t head = h->head.load(std::memory_order_acquire);
+	std::uint64_t count = std::min<std::uint64_t>(n < 0 ? 0 : n, cap - (tail - head));
+	if (count == 0) {
+		return 0;
+	}
+
+	std::uint64_t start = tail % cap;
+	std::uint64_t first_len = std::min(count, cap - start);
+	value_type* ring = data();
+	std::copy(items, items + first_len, ring + start);
+	std::copy(items + first_len, items + count, ring);
+	h->tail.store(tail + count, std::memory_order_release);
+
+	if (_event_fd >= 0) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (h->consumer_waiting.load(std::memory_order_relaxed) != 0) {
+			eventfd_write(_event_fd, 1);
+		}
+	}
+	return static_cast<int>(count);
+}
+
+int ShmRingBuffer::read(value_type* out, int n) {
+	Header* h = header();
+	const std::uint64_t cap = h->capacity;
+	std::uint64_t head = h->head.load(std::memory_order_relaxed);
+	std::uint64_t tail = h->tail.load(std::memory_order_acquire);
+	std::uint64_t count = std::min<std::uint64_t>(n < 0 ? 0 : n, tail - head);
+	if (count == 0) {
+		return 0;
+	}
+
+	std::uint64_t start = head % cap;
+	std::uint64_t first_len = std::min(count, cap - start);
+	const value_type* ring = data();
+	std::copy(ring + start, ring + start + first_len, out);
+	std::copy(ring, ring + (count - first_len), out + first_len);
+	h->head.store(head + count, std::memory_order_release);
+	return static_cast<int>(count);
+}
+
+void ShmRingBuffer::wait_readable() {
+	if (_event_fd < 0) {
+		CB_THROW(std::logic_error("Ring was created without notification"));
+	}
+	Header* h = header();
+	while (empty()) {
+		h->consumer_waiting.store(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (empty()) {
+			eventfd_t value;
+			eventfd_read(_event_fd, &value);
+		}
+		h->consumer_waiting.store(0, std::memory_order_relaxed);
+	}
+}
+
+int ShmRingBuffer::size() const {
+	Header* h = header();
+	std::uint64_t head = h->head.load(std::memory_order_acquire);
+	std::uint64_t tail = h->tail.load(std::memory_order_acquire);
+	return static_cast<int>(tail - head);
+}
+
+bool ShmRingBuffer::empty() const {
+	return size() == 0;
+}
+
+int ShmRingBuffer::capacity() const {
+	return static_cast<int>(header()->capacity);
+}
+
+int ShmRingBuffer::fd() const {
+	return _fd;
+}
+
+int ShmRingBuffer::event_fd() const {
+	return _event_fd;
+}
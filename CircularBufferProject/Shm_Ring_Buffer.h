@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "Circular_Buffer.h"
+
+/**
+ * Single-producer single-consumer ring whose header and storage live in a
+ * shared memory segment (memfd or POSIX shm) mapped by two processes.
+ * The segment holds only offsets, never pointers, so each process may map it
+ * at a different address. Read and write positions are 64-bit counters that
+ * only grow and are published with release/acquire ordering, so neither side
+ * takes a lock. Optionally an eventfd wakes a consumer blocked in
+ * wait_readable(); the producer only signals it while the consumer sleeps.
+ * Linux only.
+ */
+class ShmRingBuffer {
+	struct Header {
+		std::atomic<std::uint32_t> magic;			// Marks an initialized segment, stored last
+		std::uint32_t element_size;					// sizeof(value_type) of the creator
+		std::uint64_t capacity;						// Number of elements in the ring
+		std::uint64_t data_offset;					// Offset of the elements from the segment start
+		alignas(64) std::atomic<std::uint64_t> head;	// Elements consumed so far, written by the consumer
+		alignas(64) std::atomic<std::uint64_t> tail;	// Elements produced so far, written by the producer
+		alignas(64) std::atomic<std::uint32_t> consumer_waiting;	// Set while the consumer blocks on the eventfd
+	};
+
+	int _fd;				// Descriptor of the shared segment
+	int _event_fd;			// eventfd for wake-ups, -1 if notification is off
+	void* _base;			// Start of this process' mapping
+	std::size_t _bytes;		// Size of the mapping
+
+	ShmRingBuffer(int fd, int event_fd, bool initialize, std::uint64_t capacity);
+
+	Header* header() const;
+	value_type* data() const;
+	static std::size_t segment_size(std::uint64_t capacity);
+
+public:
+	/**
+     * Create an anonymous segment with memfd_create. Share it with another process
+     * by fork() or by passing fd() and event_fd() over a UNIX socket.
+     * @param capacity Number of elements in the ring.
+     * @param notify Whether to create an eventfd for wait_readable().
+     * @throws std::invalid_argument if the capacity is not positive.
+     * @throws std::system_error if the segment cannot be created.
+     */
+	static ShmRingBuffer create(int capacity, bool notify = false);
+
+	/**
+     * Create a named POSIX shared memory segment that other processes open by name.
+     * @param name Name for shm_open, starting with '/'.
+     * @param capacity Number of elements in the ring.
+     * @throws std::system_error if the segment cannot be created.
+     */
+	static ShmRingBuffer create_named(const std::string& name, int capacity);
+
+	/**
+     * Map a named segment created by create_named().
+     * @throws std::system_error if the segment cannot be opened or was not created by ShmRingBuffer.
+     */
+	static ShmRingBuffer open_named(const std::string& name);
+
+	/**
+     * Map a segment from a descriptor received from the creating process.
+     * Takes ownership of both descriptors.
+     * @param fd Descriptor of the segment.
+     * @param event_fd eventfd for notification, -1 if none.
+     */
+	static ShmRingBuffer attach(int fd, int event_fd = -1);
+
+	/**
+     * Remove a name created by create_named(). Existing mappings stay valid.
+     */
+	static void unlink(const std::string& name);
+
+	ShmRingBuffer(ShmRingBuffer&& other) noexcept;
+	ShmRingBuffer& operator=(ShmRingBuffer&& other) noexcept;
+	ShmRingBuffer(const ShmRingBuffer&) = delete;
+	ShmRingBuffer& operator=(const ShmRingBuffer&) = delete;
+	~ShmRingBuffer();
+
+	/**
+     * Copy up to n elements into the ring. Producer side only; never blocks.
+     * @return Number of elements written, less than n if the ring fills up.
+     */
+	int write(const value_type* items, int n);
+
+	/**
+     * Copy up to n elements out of the ring. Consumer side only; never blocks.
+     * @return Number of elements read, 0 if the ring is empty.
+     */
+	int read(value_type* out, int n);
+
+	/**
+     * Block until the ring is not empty. Consumer side only; requires notification.
+     * @throws std::logic_error if the ring was created without an eventfd.
+     */
+	void wait_readable();
+
+	int size() const;
+	bool empty() const;
+	int capacity() const;
+	int fd() const;
+	int event_fd() const;
+};
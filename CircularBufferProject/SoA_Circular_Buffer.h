@@ -0,0 +1,204 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Circular buffer of records stored as a structure of arrays: every field
+ * has its own column array and all columns share one head and size.
+ * Scanning a single field touches only that column, which is contiguous
+ * apart from the wrap point and can be processed at memory bandwidth.
+ */
+template <typename... Fields>
+class SoACircularBuffer {
+	static_assert(sizeof...(Fields) > 0, "SoACircularBuffer needs at least one field");
+
+	std::tuple<std::vector<Fields>...> columns;	// One array per field
+	int _capacity;								// Total capacity of the buffer
+	int _size;									// Current number of records in the buffer
+	int _idx_head;								// Index of the first record (head)
+
+	int physical(int i) const {
+		int idx = _idx_head + i;
+		return idx < _capacity ? idx : idx - _capacity;
+	}
+
+	template <std::size_t... I>
+	void store(std::index_sequence<I...>, int idx, const std::tuple<Fields...>& row) {
+		((std::get<I>(columns)[idx] = std::get<I>(row)), ...);
+	}
+
+	template <std::size_t... I>
+	std::tuple<Fields...> load(std::index_sequence<I...>, int idx) const {
+		return std::tuple<Fields...>(std::get<I>(columns)[idx]...);
+	}
+
+	template <typename T>
+	static void copy_column(std::vector<T>& column, const T* src, int start, int first_len, int n) {
+		std::copy(src, src + first_len, column.data() + start);
+		std::copy(src + first_len, src + n, column.data());
+	}
+
+	template <std::size_t... I>
+	void append_columns(std::index_sequence<I...>, int start, int first_len, int n, const Fields*... data) {
+		(copy_column(std::get<I>(columns), data, start, first_len, n), ...);
+	}
+
+public:
+	typedef std::tuple<Fields...> value_type;
+
+	template <std::size_t I>
+	using column_type = typename std::tuple_element<I, value_type>::type;
+
+	/**
+     * Constructor to initialize a buffer with a specific capacity.
+     * @param capacity The maximum number of records the buffer can hold.
+     * @throws std::invalid_argument if the capacity is negative.
+     */
+	explicit SoACircularBuffer(int capacity) : _capacity(capacity), _size(0), _idx_head(0) {
+		if (capacity < 0) {
+			CB_THROW(std::invalid_argument("Capacity must be non-negative"));
+		}
+		std::apply([capacity](auto&... column) { (column.resize(capacity), ...); }, columns);
+	}
+
+	/**
+     * Add a record to the end of the buffer.
+     * If the buffer is full, the first record is overwritten.
+     * @param row The record to add.
+     */
+	void push_back(const value_type& row) {
+		if (_capacity == 0) {
+			return;
+		}
+		if (full()) {
+			pop_front();
+		}
+		store(std::index_sequence_for<Fields...>(), physical(_size), row);
+		_size++;
+	}
+
+	void push_back(const Fields&... fields) {
+		push_back(value_type(fields...));
+	}
+
+	/**
+     * Append n records given column by column, one array per field.
+     * If the buffer overflows, the oldest records are overwritten; if n exceeds
+     * the capacity only the last capacity() records are kept.
+     * @param n Number of records to append.
+     * @param data One pointer per field to n values.
+     */
+	void append(int n, const Fields*... data) {
+		if (n <= 0 || _capacity == 0) {
+			return;
+		}
+		if (n >= _capacity) {
+			int skip = n - _capacity;
+			_idx_head = 0;
+			_size = 0;
+			append_columns(std::index_sequence_for<Fields...>(), 0, _capacity, _capacity, (data + skip)...);
+			_size = _capacity;
+			return;
+		}
+		int evict = std::max(0, _size + n - _capacity);
+		_idx_head = physical(evict);
+		_size -= evict;
+		int start = physical(_size);
+		int first_len = std::min(n, _capacity - start);
+		append_columns(std::index_sequence_for<Fields...>(), start, first_len, n, data...);
+		_size += n;
+	}
+
+	/**
+     * Remove the first record from the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	void pop_front() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		_idx_head = physical(1);
+		_size--;
+	}
+
+	/**
+     * Remove the last record from the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	void pop_back() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		_size--;
+	}
+
+	/**
+     * Assemble a record by index.
+     * @param i Index of the record to read.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	value_type row(int i) const {
+		if (i < 0 || i >= _size) {
+			CB_THROW(std::out_of_range("Index out of range"));
+		}
+		return load(std::index_sequence_for<Fields...>(), physical(i));
+	}
+
+	/**
+     * Access a single field of a record by index without bounds checking.
+     * @tparam I Index of the field.
+     * @param i Index of the record.
+     */
+	template <std::size_t I>
+	column_type<I>& get(int i) {
+		return std::get<I>(columns)[physical(i)];
+	}
+	template <std::size_t I>
+	const column_type<I>& get(int i) const {
+		return std::get<I>(columns)[physical(i)];
+	}
+
+	/**
+     * Get one field of all records as at most two contiguous segments.
+     * @tparam I Index of the field.
+     * @return Views valid until the next modification.
+     */
+	template <std::size_t I>
+	SegmentPair<column_type<I>> column() {
+		return column_segments<column_type<I>>(std::get<I>(columns).data());
+	}
+	template <std::size_t I>
+	SegmentPair<const column_type<I>> column() const {
+		return column_segments<const column_type<I>>(std::get<I>(columns).data());
+	}
+
+	int size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	bool full() const { return _size == _capacity; }
+	int capacity() const { return _capacity; }
+
+	/**
+     * Clear the buffer, removing all records.
+     */
+	void clear() {
+		_size = 0;
+		_idx_head = 0;
+	}
+
+private:
+	template <typename T>
+	SegmentPair<T> column_segments(T* data) const {
+		int first_len = std::min(_size, _capacity - _idx_head);
+		SegmentPair<T> result;
+		result.first.data = data + _idx_head;
+		result.first.size = first_len;
+		result.second.data = data;
+		result.second.size = _size - first_len;
+		return result;
+	}
+};
@@ -0,0 +1,329 @@
+#pragma once
+#include <array>
+#include <stdexcept>
+#include "Circular_Buffer.h"
+
+/**
+ * Circular buffer with the capacity fixed at compile time.
+ * Mirrors the public API of CircularBuffer so code can switch between the two
+ * by changing a type alias. Storage is an std::array inside the object, there
+ * is no heap pointer, end index or full flag, and every operation is constexpr.
+ * When N is a power of two the index wrap-around folds to a bit mask.
+ */
+template <typename T, int N>
+class StaticCircularBuffer {
+	static_assert(N > 0, "StaticCircularBuffer capacity must be positive");
+
+	std::array<T, N> buffer;	// Element storage
+	size_type _size;			// Current number of elements in the buffer
+	size_type _idx_head;		// Index of the first element (head) in the buffer
+
+	// Maps i in [0, 2 * N) onto [0, N).
+	static constexpr size_type wrap(size_type i) {
+		if constexpr ((N & (N - 1)) == 0) {
+			return i & (N - 1);
+		} else {
+			return i < N ? i : i - N;
+		}
+	}
+
+	constexpr void reverse(size_type first, size_type last) {
+		for (--last; first < last; ++first, --last) {
+			T tmp = buffer[first];
+			buffer[first] = buffer[last];
+			buffer[last] = tmp;
+		}
+	}
+
+public:
+	typedef T value_type;
+
+	static constexpr int inline_capacity = N;
+
+	constexpr StaticCircularBuffer() : buffer{}, _size(0), _idx_head(0) {}
+
+	/**
+     * Constructor kept for API compatibility with CircularBuffer.
+     * @param capacity Must be equal to N.
+     * @throws std::invalid_argument if the capacity differs from N.
+     */
+	constexpr explicit StaticCircularBuffer(size_type capacity) : buffer{}, _size(0), _idx_head(0) {
+		if (capacity != N) {
+			CB_THROW(std::invalid_argument("Capacity of a static buffer is fixed"));
+		}
+	}
+
+	/**
+     * Constructor that fills the whole buffer with the given element.
+     * @param capacity Must be equal to N.
+     * @param elem The value to initialize all elements in the buffer.
+     * @throws std::invalid_argument if the capacity differs from N.
+     */
+	constexpr StaticCircularBuffer(size_type capacity, const T& elem) : buffer{}, _size(N), _idx_head(0) {
+		if (capacity != N) {
+			CB_THROW(std::invalid_argument("Capacity of a static buffer is fixed"));
+		}
+		for (size_type i = 0; i < N; i++) {
+			buffer[i] = elem;
+		}
+	}
+
+	/**
+     * Access an element by index without bounds checking.
+     * @param i Index of the element to access.
+     * @return Reference to the element at the specified index.
+     */
+	constexpr T& operator[](size_type i) { return buffer[wrap(_idx_head + i)]; }
+	constexpr const T& operator[](size_type i) const { return buffer[wrap(_idx_head + i)]; }
+
+	/**
+     * Access an element by index with bounds checking.
+     * @param i Index of the element to access.
+     * @return Reference to the element at the specified index.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+	constexpr T& at(size_type i) {
+		if (i < 0 || i >= _size) {
+			CB_THROW(std::out_of_range("Index out of range"));
+		}
+		return (*this)[i];
+	}
+	constexpr const T& at(size_type i) const {
+		if (i < 0 || i >= _size) {
+			CB_THROW(std::out_of_range("Index out of range"));
+		}
+		return (*this)[i];
+	}
+
+	/**
+     * Get a reference to the first element in the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	constexpr T& front() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		return buffer[_idx_head];
+	}
+	constexpr const T& front() const {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		return buffer[_idx_head];
+	}
+
+	/**
+     * Get a reference to the last element in the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	constexpr T& back() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		return (*this)[_size - 1];
+	}
+	constexpr const T& back() const {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		return (*this)[_size - 1];
+	}
+
+	/**
+     * Linearize the buffer to make it contiguous in memory.
+     * @return Pointer to the linearized buffer.
+     */
+	constexpr T* linearize() {
+		if (!is_linearized()) {
+			reverse(0, _idx_head);
+			reverse(_idx_head, N);
+			reverse(0, N);
+			_idx_head = 0;
+		}
+		return buffer.data();
+	}
+
+	/**
+     * Check if the buffer is already linearized.
+     */
+	constexpr bool is_linearized() const { return _idx_head + _size <= N; }
+
+	/**
+     * Rotate the buffer so that the new beginning is at the specified index.
+     * @param new_begin The index of the new beginning of the buffer.
+     * @throws std::out_of_range if the index is invalid.
+     */
+	constexpr void rotate(size_type new_begin) {
+		if (new_begin < 0 || new_begin >= _size) {
+			CB_THROW(std::out_of_range("Invalid rotation index"));
+		}
+		_idx_head = wrap(_idx_head + new_begin);
+	}
+
+	constexpr size_type size() const { return _size; }
+	constexpr bool empty() const { return _size == 0; }
+	constexpr bool full() const { return _size == N; }
+	constexpr size_type reserve() const { return N - _size; }
+	static constexpr size_type capacity() { return N; }
+	static constexpr bool is_inline() { return true; }
+
+	/**
+     * Kept for API compatibility with CircularBuffer.
+     * @param new_capacity Must be equal to N.
+     * @throws std::invalid_argument if the capacity differs from N.
+     */
+	constexpr void set_capacity(size_type new_capacity) {
+		if (new_capacity != N) {
+			CB_THROW(std::invalid_argument("Capacity of a static buffer is fixed"));
+		}
+	}
+
+	/**
+     * Resize the buffer to hold a specific number of elements.
+     * @param new_size The new size of the buffer, at most N.
+     * @param item The value to initialize new elements if the buffer is expanded.
+     * @throws std::invalid_argument if the new size exceeds N.
+     */
+	constexpr void resize(size_type new_size, const T& item = T()) {
+		if (new_size < 0 || new_size > N) {
+			CB_THROW(std::invalid_argument("New size exceeds the fixed capacity"));
+		}
+		while (_size < new_size) {
+			push_back(item);
+		}
+		_size = new_size;
+	}
+
+	/**
+     * Swap the contents of this buffer with another buffer.
+     */
+	constexpr void swap(StaticCircularBuffer& cb) {
+		for (size_type i = 0; i < N; i++) {
+			T tmp = buffer[i];
+			buffer[i] = cb.buffer[i];
+			cb.buffer[i] = tmp;
+		}
+		size_type size = _size;
+		_size = cb._size;
+		cb._size = size;
+		size_type head = _idx_head;
+		_idx_head = cb._idx_head;
+		cb._idx_head = head;
+	}
+
+	/**
+     * Add an element to the end of the buffer.
+     * If the buffer is full, the first element is overwritten.
+     */
+	constexpr void push_back(const T& item = T()) {
+		if (full()) {
+			buffer[_idx_head] = item;
+			_idx_head = wrap(_idx_head + 1);
+			return;
+		}
+		buffer[wrap(_idx_head + _size)] = item;
+		_size++;
+	}
+
+	/**
+     * Add an element to the front of the buffer.
+     * If the buffer is full, the last element is overwritten.
+     */
+	constexpr void push_front(const T& item = T()) {
+		_idx_head = wrap(_idx_head + N - 1);
+		buffer[_idx_head] = item;
+		if (!full()) {
+			_size++;
+		}
+	}
+
+	/**
+     * Remove the last element from the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	constexpr void pop_back() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		_size--;
+	}
+
+	/**
+     * Remove the first element from the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	constexpr void pop_front() {
+		if (empty()) {
+			CB_THROW(std::out_of_range("Buffer is empty"));
+		}
+		_idx_head = wrap(_idx_head + 1);
+		_size--;
+	}
+
+	/**
+     * Insert an element at a specific position in the buffer.
+     * If the buffer is full, the first element is discarded to make room.
+     * @throws std::out_of_range if the position is invalid.
+     */
+	constexpr void insert(size_type pos, const T& item = T()) {
+		if (pos > _size || pos < 0) {
+			CB_THROW(std::out_of_range("Bad pos!"));
+		}
+		if (full()) {
+			if (pos == 0) {
+				return;
+			}
+			pop_front();
+			pos--;
+		}
+		for (size_type i = _size; i > pos; --i) {
+			(*this)[i] = (*this)[i - 1];
+		}
+		(*this)[pos] = item;
+		_size++;
+	}
+
+	/**
+     * Remove a range of elements from the buffer.
+     * @param first The start of the range to remove (inclusive).
+     * @param last The end of the range to remove (exclusive).
+     * @throws std::out_of_range if the range is invalid.
+     */
+	constexpr void erase(size_type first, size_type last) {
+		if (first >= last || first < 0 || last > _size) {
+			CB_THROW(std::out_of_range("Index out of range"));
+		}
+		size_type count = last - first;
+		for (size_type i = first; i < _size - count; i++) {
+			(*this)[i] = (*this)[i + count];
+		}
+		_size -= count;
+	}
+
+	/**
+     * Clear the buffer, removing all elements.
+     * @throws std::underflow_error if the buffer is already empty.
+     */
+	constexpr void clear() {
+		if (empty()) {
+			CB_THROW(std::underflow_error("Buffer is empty already"));
+		}
+		_size = 0;
+		_idx_head = 0;
+	}
+};
+
+template <typename T, int N>
+constexpr bool operator==(const StaticCircularBuffer<T, N>& a, const StaticCircularBuffer<T, N>& b) {
+	if (a.size() != b.size()) return false;
+
+	for (size_type i = 0; i < a.size(); i++) {
+		if (a[i] != b[i]) return false;
+	}
+	return true;
+}
+
+template <typename T, int N>
+constexpr bool operator!=(const StaticCircularBuffer<T, N>& a, const StaticCircularBuffer<T, N>& b) {
+	return !(a == b);
+}
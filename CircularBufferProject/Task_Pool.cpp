@@ -0,0 +1,153 @@
+#include<algorithm>
+#include<chrono>
+#include"Task_Pool.h"
+
+namespace {
+
+// Pool and index of the worker running on this thread, if any.
+thread_local const TaskPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+}
+
+TaskPool::TaskPool(int threads) {
+	if (threads <= 0) {
+		threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	_pending.store(0, std::memory_order_relaxed);
+	_submitted.store(0, std::memory_order_relaxed);
+	_stop = false;
+	for (int i = 0; i < threads; i++) {
+		_deques.emplace_back(new WorkStealingDeque<Task*>());
+	}
+	for (int i = 0; i < threads; i++) {
+		_workers.emplace_back(&TaskPool::worker_loop, this, i);
+	}
+}
+
+TaskPool::~TaskPool() {
+	wait();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (std::thread& worker : _workers) {
+		worker.join();
+	}
+}
+
+int TaskPool::worker_index() const {
+	return current_pool == this ? current_worker : -1;
+}
+
+void TaskPool::submit(Task task) {
+	Task* heap_task = new Task(std::move(task));
+	_pending.fetch_add(1, std::memory_order_relaxed);
+	int self = worker_index();
+	if (self >= 0) {
+		_deques[self]->push(heap_task);
+	} else {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_injected.push_back(heap_task);
+	}
+	_submitted.fetch_add(1, std::memory_order_release);
+	_wake.notify_one();
+}
+
+TaskPool::Task* TaskPool::take(int self) {
+	if (self >= 0) {
+		if (std::optional<Task*> own = _deques[self]->pop()) {
+			return *own;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_injected.empty()) {
+			Task* task = _injected.front();
+			_injected.pop_front();
+			return task;
+		}
+	}
+	int n = threads();
+	for (int i = 1; i <= n; i++) {
+		int victim = (self + i + n) % n;
+		if (victim == self) {
+			continue;
+		}
+		if (std::optional<Task*> stolen = _deques[victim]->steal()) {
+			return *stolen;
+		}
+	}
+	return nullptr;
+}
+
+void TaskPool::execute(Task* task) {
+	(*task)();
+	delete task;
+	if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_idle.notify_all();
+	}
+}
+
+bool TaskPool::run_one() {
+	Task* task = take(worker_index());
+	if (task == nullptr) {
+		return false;
+	}
+	execute(task);
+	return true;
+}
+
+void TaskPool::worker_loop(int self) {
+	current_pool = this;
+	current_worker = self;
+	for (;;) {
+		std::uint64_t seen = _submitted.load(std::memory_order_acquire);
+		if (Task* task = take(self)) {
+			execute(task);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_stop) {
+			return;
+		}
+		_wake.wait_for(lock, std::chrono::milliseconds(1), [&]() {
+			return _stop || _submitted.load(std::memory_order_acquire) != seen;
+		});
+	}
+}
+
+void TaskPool::wait() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle.wait(lock, [&]() { return _pending.load(std::memory_order_acquire) == 0; });
+}
+
+int TaskPool::threads() const {
+	return static_cast<int>(_deques.size());
+}
+
+TaskGroup::TaskGroup(TaskPool& pool) : _pool(pool) {
+	_pending.store(0, std::memory_order_relaxed);
+}
+
+TaskGroup::~TaskGroup() {
+	wait();
+}
+
+void TaskGroup::run(TaskPool::Task task) {
+	_pending.fetch_add(1, std::memory_order_relaxed);
+	_pool.submit([this, task = std::move(task)]() {
+		task();
+		_pending.fetch_sub(1, std::memory_order_release);
+	});
+}
+
+void TaskGroup::wait() {
+	while (_pending.load(std::memory_order_acquire) != 0) {
+		if (!_pool.run_one()) {
+			std::this_thread::yield();
+		}
+	}
+}
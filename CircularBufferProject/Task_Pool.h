@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Work_Stealing_Deque.h"
+
+/**
+ * Fixed set of worker threads scheduling tasks by work stealing. A task
+ * submitted from a worker goes to that worker's WorkStealingDeque and is
+ * run LIFO, which keeps fork-join recursion cache-friendly; tasks submitted
+ * from other threads go to a mutex-protected injection queue. Idle workers
+ * take from their own deque, then the injection queue, then steal the
+ * oldest task of another worker. Workers with nothing to do sleep on a
+ * condition variable for at most a millisecond between attempts.
+ */
+class TaskPool {
+public:
+	typedef std::function<void()> Task;
+
+	/**
+     * Constructor that starts the workers.
+     * @param threads Number of workers, 0 for all hardware threads.
+     */
+	explicit TaskPool(int threads = 0);
+
+	/**
+     * Waits for all submitted tasks, then stops the workers.
+     */
+	~TaskPool();
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	/**
+     * Schedule a task. Safe from any thread, including from inside a task.
+     * Tasks must not throw.
+     */
+	void submit(Task task);
+
+	/**
+     * Run one pending task on the calling thread, if there is one.
+     * Lets a thread that waits for other tasks help instead of blocking.
+     * @return True if a task was run.
+     */
+	bool run_one();
+
+	/**
+     * Block until every submitted task has finished. Must not be called from a task;
+     * use TaskGroup::wait() for fork-join inside tasks.
+     */
+	void wait();
+
+	int threads() const;
+
+private:
+	std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> _deques;	// One per worker
+	std::vector<std::thread> _workers;				// Worker threads
+	std::deque<Task*> _injected;					// Tasks submitted from outside the pool
+	std::mutex _mutex;								// Guards _injected and the sleeps
+	std::condition_variable _wake;					// Signals new work or stop to idle workers
+	std::condition_variable _idle;					// Signals that _pending reached zero
+	std::atomic<std::int64_t> _pending;				// Submitted tasks not finished yet
+	std::atomic<std::uint64_t> _submitted;			// Number of submit() calls, wakes sleepers
+	bool _stop;										// Set by the destructor, guarded by _mutex
+
+	int worker_index() const;
+	Task* take(int self);
+	void execute(Task* task);
+	void worker_loop(int self);
+};
+
+/**
+ * Set of tasks that can be waited for as a unit, for fork-join parallelism.
+ * wait() runs other tasks of the pool while the group is unfinished, so it
+ * may be called from inside a task without tying up the worker.
+ */
+class TaskGroup {
+	TaskPool& _pool;					// Pool running the tasks
+	std::atomic<std::int64_t> _pending;	// Tasks of the group not finished yet
+
+public:
+	explicit TaskGroup(TaskPool& pool);
+
+	/**
+     * Waits for the group's tasks.
+     */
+	~TaskGroup();
+
+	/**
+     * Schedule a task as part of the group.
+     */
+	void run(TaskPool::Task task);
+
+	/**
+     * Help the pool until all tasks of the group have finished.
+     */
+	void wait();
+};
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include <cstring>
+#include <string>
+#include "../Bip_Buffer.h"
+
+// Запись сообщения с префиксом длины прямо в зарезервированную область
+static bool write_message(BipBuffer& bb, const std::string& msg) {
+    Segment<byte_type> region = bb.reserve(static_cast<int>(msg.size()) + 1);
+    if (region.empty()) {
+        return false;
+    }
+    region[0] = static_cast<byte_type>(msg.size());
+    std::memcpy(region.data + 1, msg.data(), msg.size());
+    bb.commit(region.size);
+    return true;
+}
+
+static std::string read_message(BipBuffer& bb) {
+    Segment<const byte_type> region = bb.read();
+    int len = region[0];
+    std::string msg(reinterpret_cast<const char*>(region.data + 1), len);
+    bb.release(len + 1);
+    return msg;
+}
+
+TEST(BipBufferTest, ReserveCommitReadRelease) {
+    BipBuffer bb(16);
+    EXPECT_TRUE(bb.empty());
+
+    Segment<byte_type> region = bb.reserve(10);
+    ASSERT_EQ(region.size, 10);
+    EXPECT_EQ(bb.reserved(), 10);
+    region[0] = 1;
+    region[1] = 2;
+    bb.commit(2); // остаток резерва возвращается
+    EXPECT_EQ(bb.size(), 2);
+    EXPECT_EQ(bb.reserved(), 0);
+
+    Segment<const byte_type> data = bb.read();
+    ASSERT_EQ(data.size, 2);
+    EXPECT_EQ(data[1], 2);
+    bb.release(2);
+    EXPECT_TRUE(bb.empty());
+
+    EXPECT_THROW(bb.commit(1), std::invalid_argument);
+    EXPECT_THROW(bb.release(1), std::out_of_range);
+    EXPECT_TRUE(bb.reserve(17).empty());
+}
+
+// Сообщение, не помещающееся в хвост, пишется с начала, хвост пропускается
+TEST(BipBufferTest, SkipsTailGap) {
+    BipBuffer bb(16);
+    ASSERT_TRUE(write_message(bb, "abcdef"));  // [0, 7)
+    ASSERT_TRUE(write_message(bb, "ghijk"));   // [7, 13)
+    EXPECT_EQ(read_message(bb), "abcdef");     // свободно [0, 7) и [13, 16)
+
+    ASSERT_TRUE(write_message(bb, "lmnop"));   // не помещается в хвост -> [0, 6)
+    EXPECT_FALSE(write_message(bb, "qr"));     // между B и A остался 1 байт
+    EXPECT_EQ(bb.size(), 12);
+
+    EXPECT_EQ(read_message(bb), "ghijk");
+    EXPECT_EQ(read_message(bb), "lmnop");
+    EXPECT_TRUE(bb.empty());
+}
+
+TEST(BipBufferTest, StreamOfMessages) {
+    BipBuffer bb(64);
+    int written = 0;
+    int read = 0;
+    for (int round = 0; round < 200; ++round) {
+        std::string msg(1 + round % 13, static_cast<char>('a' + round % 26));
+        while (!write_message(bb, msg)) {
+            std::string expected(1 + read % 13, static_cast<char>('a' + read % 26));
+            ASSERT_EQ(read_message(bb), expected);
+            read++;
+        }
+        written++;
+    }
+    while (!bb.empty()) {
+        std::string expected(1 + read % 13, static_cast<char>('a' + read % 26));
+        ASSERT_EQ(read_message(bb), expected);
+        read++;
+    }
+    EXPECT_EQ(read, written);
+}
@@ -1,4 +1,9 @@
 #include "gtest/gtest.h"
+#include <limits>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "../Circular_Buffer.h"
 
 // === Базовые тесты ===
@@ -243,6 +248,463 @@ TEST(CircularBufferTest, Resize) {
     EXPECT_EQ(cb[1], 20);
 }
 
+// Тест для segments(): два непрерывных участка в логическом порядке
+TEST(CircularBufferTest, Segments) {
+    CircularBuffer cb(4);
+    for (int i = 1; i <= 6; ++i) {
+        cb.push_back(i);
+    }
+    SegmentPair<value_type> parts = cb.segments();
+    ASSERT_EQ(parts.size(), 4);
+    EXPECT_EQ(parts.first.size, 2);
+    EXPECT_EQ(parts.first[0], 3);
+    EXPECT_EQ(parts.second[0], 5);
+    EXPECT_EQ(parts.second[1], 6);
+
+    cb.linearize();
+    EXPECT_TRUE(cb.segments().second.empty());
+}
+
+// Тест для try_*: ошибки без исключений
+TEST(CircularBufferTest, TryAccessAndPop) {
+    CircularBuffer cb(3);
+    value_type out = -1;
+
+    EXPECT_FALSE(cb.try_front().has_value());
+    EXPECT_FALSE(cb.try_back().has_value());
+    EXPECT_FALSE(cb.try_at(0).has_value());
+    EXPECT_FALSE(cb.try_pop_front(out));
+    EXPECT_FALSE(cb.try_pop_back());
+    EXPECT_FALSE(cb.try_clear());
+    EXPECT_EQ(out, -1);
+
+    for (int i = 1; i <= 4; ++i) {
+        cb.push_back(i * 10); // 20 30 40
+    }
+    EXPECT_EQ(cb.try_front().value(), 20);
+    EXPECT_EQ(cb.try_back().value(), 40);
+    EXPECT_EQ(cb.try_at(1).value(), 30);
+    EXPECT_FALSE(cb.try_at(3).has_value());
+    EXPECT_FALSE(cb.try_at(-1).has_value());
+
+    EXPECT_TRUE(cb.try_pop_front(out));
+    EXPECT_EQ(out, 20);
+    EXPECT_TRUE(cb.try_pop_back(out));
+    EXPECT_EQ(out, 40);
+    EXPECT_TRUE(cb.try_pop_front());
+    EXPECT_TRUE(cb.empty());
+
+    cb.push_back(1);
+    EXPECT_TRUE(cb.try_clear());
+    EXPECT_TRUE(cb.empty());
+}
+
+// Тест для consume(): обработка пакета по непрерывным участкам
+TEST(CircularBufferTest, ConsumeSegments) {
+    CircularBuffer cb(5);
+    for (int i = 1; i <= 7; ++i) {
+        cb.push_back(i); // 3 4 5 6 7, голова в середине массива
+    }
+
+    std::vector<value_type> seen;
+    int calls = 0;
+    auto collect = [&](const value_type* data, int n) {
+        calls++;
+        seen.insert(seen.end(), data, data + n);
+    };
+
+    EXPECT_EQ(cb.consume(4, collect), 4);
+    EXPECT_EQ(calls, 2); // переход через границу массива
+    EXPECT_EQ(seen, (std::vector<value_type>{3, 4, 5, 6}));
+    EXPECT_EQ(cb.size(), 1);
+    EXPECT_EQ(cb.front(), 7);
+
+    cb.push_back(8);
+    EXPECT_EQ(cb.consume_all(collect), 2);
+    EXPECT_TRUE(cb.empty());
+    EXPECT_EQ(seen.back(), 8);
+    EXPECT_EQ(cb.consume_all(collect), 0);
+}
+
+// Номера последовательности не меняются при вытеснении и pop_front
+TEST(CircularBufferTest, SequenceNumbers) {
+    CircularBuffer cb(4);
+    EXPECT_EQ(cb.first_seq(), 0u);
+    EXPECT_EQ(cb.next_seq(), 0u);
+    EXPECT_THROW(cb.last_seq(), std::out_of_range);
+
+    for (int i = 0; i < 10; i++) {
+        cb.push_back(i * 10);
+    }
+    // Остались элементы с номерами 6..9
+    EXPECT_EQ(cb.first_seq(), 6u);
+    EXPECT_EQ(cb.last_seq(), 9u);
+    EXPECT_EQ(cb.next_seq(), 10u);
+    EXPECT_EQ(cb.at_seq(7), 70);
+    EXPECT_THROW(cb.at_seq(10), std::out_of_range);
+    try {
+        cb.at_seq(3);
+        FAIL();
+    } catch (const sequence_overwritten& e) {
+        EXPECT_EQ(e.oldest(), 6u);
+    }
+
+    // Чтение с номера через точку переноса
+    SegmentPair<const value_type> tail = cb.read_from_seq(7);
+    ASSERT_EQ(tail.size(), 3);
+    std::vector<int> seen;
+    for (int v : tail.first) seen.push_back(v);
+    for (int v : tail.second) seen.push_back(v);
+    EXPECT_EQ(seen, (std::vector<int>{70, 80, 90}));
+    EXPECT_TRUE(cb.read_from_seq(10).empty());
+    EXPECT_THROW(cb.read_from_seq(11), std::out_of_range);
+    EXPECT_THROW(cb.read_from_seq(5), sequence_overwritten);
+
+    cb.pop_front();
+    EXPECT_EQ(cb.first_seq(), 7u);
+    // push_front нумерует содержимое заново, после всех выданных номеров
+    cb.push_front(-1);
+    EXPECT_EQ(cb.first_seq(), 11u);
+    EXPECT_EQ(cb.at_seq(11), -1);
+    EXPECT_THROW(cb.read_from_seq(10), sequence_overwritten);
+
+    cb.clear();
+    EXPECT_EQ(cb.first_seq(), 15u);
+    cb.push_back(100);
+    EXPECT_EQ(cb.at_seq(15), 100);
+
+    CircularBuffer copy(cb);
+    EXPECT_EQ(copy.first_seq(), 15u);
+}
+
+// pop_back и push_front не выдают номер повторно, потребитель узнаёт о перенумерации
+TEST(CircularBufferTest, SequenceNumbersNeverReused) {
+    CircularBuffer cb(8);
+    for (int i = 0; i < 10; i++) {
+        cb.push_back(i * 10);
+    }
+    sequence_type seen = cb.last_seq();
+    EXPECT_EQ(cb.at_seq(seen), 90);
+    cb.pop_back();
+    cb.push_back(999);
+    EXPECT_GT(cb.last_seq(), seen);
+    sequence_type resume = 0;
+    try {
+        cb.read_from_seq(seen + 1);
+        FAIL();
+    } catch (const sequence_overwritten& e) {
+        resume = e.oldest();
+    }
+    SegmentPair<const value_type> rest = cb.read_from_seq(resume);
+    ASSERT_EQ(rest.size(), 8);
+    EXPECT_EQ(cb.at_seq(cb.last_seq()), 999);
+
+    // push_front при first_seq() == 0 тоже не сдвигает старые номера назад
+    CircularBuffer front(4);
+    front.push_front(1);
+    EXPECT_EQ(front.at_seq(0), 1);
+    front.push_back(2);
+    front.push_back(3);
+    EXPECT_EQ(front.at_seq(1), 2);
+    front.push_front(0);
+    EXPECT_THROW(front.at_seq(1), sequence_overwritten);
+    EXPECT_EQ(front.at_seq(front.first_seq()), 0);
+
+    // Вставка в конец и удаление с начала сохраняют номера
+    front.pop_back();
+    sequence_type first = front.first_seq();
+    front.insert(front.size(), 7);
+    EXPECT_EQ(front.at_seq(first), 0);
+    front.erase(0, 1);
+    EXPECT_EQ(front.first_seq(), first + 1);
+    EXPECT_EQ(front.at_seq(first + 1), 1);
+
+    // Случайные операции: один номер никогда не указывает на два разных значения
+    std::map<sequence_type, value_type> issued;
+    unsigned state = 7;
+    for (int step = 0; step < 5000; step++) {
+        state = state * 1103515245u + 12345u;
+        int op = (state >> 16) % 7;
+        if (op <= 1) {
+            cb.push_back(step);
+        } else if (op == 2) {
+            cb.push_front(step);
+        } else if (op == 3 && !cb.empty()) {
+            cb.pop_back();
+        } else if (op == 4 && !cb.empty()) {
+            cb.pop_front();
+        } else if (op == 5) {
+            cb.insert(cb.size() / 2, step);
+        } else if (cb.size() > 1) {
+            cb.erase(1, 2);
+        }
+        const CircularBuffer& view = cb;
+        for (size_type i = 0; i < view.size(); i++) {
+            auto it = issued.emplace(view.first_seq() + i, view[i]).first;
+            ASSERT_EQ(it->second, view[i]) << "sequence " << it->first << " was reused";
+        }
+    }
+}
+
+// Колбэки водяных знаков срабатывают только при пересечении, с гистерезисом
+TEST(CircularBufferTest, Watermarks) {
+    CircularBuffer cb(8);
+    int highs = 0;
+    int lows = 0;
+    cb.set_watermarks(6, 2, [&]() { highs++; }, [&]() { lows++; });
+    EXPECT_FALSE(cb.above_high_watermark());
+
+    for (int i = 0; i < 6; i++) {
+        cb.push_back(i);
+    }
+    EXPECT_EQ(highs, 1);
+    EXPECT_TRUE(cb.above_high_watermark());
+
+    // Перезапись и колебания между порогами ничего не вызывают
+    for (int i = 0; i < 10; i++) {
+        cb.push_back(i);
+    }
+    cb.pop_front();
+    cb.pop_front();
+    cb.pop_front();
+    cb.push_back(1);
+    EXPECT_EQ(highs, 1);
+    EXPECT_EQ(lows, 0);
+
+    while (cb.size() > 2) {
+        cb.pop_back();
+    }
+    EXPECT_EQ(lows, 1);
+    EXPECT_FALSE(cb.above_high_watermark());
+    cb.resize(7);
+    EXPECT_EQ(highs, 2);
+    EXPECT_EQ(cb.back(), 0);
+    cb.clear();
+    EXPECT_EQ(lows, 2);
+
+    // Копия не наследует водяные знаки, перемещение переносит их
+    cb.resize(6);
+    CircularBuffer copy(cb);
+    EXPECT_FALSE(copy.above_high_watermark());
+    CircularBuffer moved(std::move(cb));
+    EXPECT_TRUE(moved.above_high_watermark());
+    moved.clear_watermarks();
+    moved.clear();
+    EXPECT_EQ(lows, 2);
+
+    EXPECT_THROW(moved.set_watermarks(2, 2), std::invalid_argument);
+}
+
+// Флаг можно опрашивать из другого потока, пока владелец меняет и снимает водяные знаки
+TEST(CircularBufferTest, WatermarkFlagPolledConcurrently) {
+    CircularBuffer cb(8);
+    std::atomic<bool> done(false);
+    std::thread poller([&]() {
+        while (!done.load()) {
+            cb.above_high_watermark();
+        }
+    });
+    for (int i = 0; i < 2000; i++) {
+        cb.set_watermarks(2, 1);
+        cb.push_back(i);
+        cb.push_back(i);
+        cb.clear_watermarks();
+        cb.clear();
+    }
+    done = true;
+    poller.join();
+    EXPECT_FALSE(cb.above_high_watermark());
+}
+
+// Ёмкость больше 2^32: индексы не переполняются, память берётся через mmap
+TEST(CircularBufferTest, HugeCapacityWrapAround) {
+    if (sizeof(size_type) < 8) {
+        GTEST_SKIP() << "size_type is 32-bit";
+    }
+    // Сдвиг в 64 битах: в сборке с 32-битным size_type тест пропускается выше
+    const size_type capacity = static_cast<size_type>((std::int64_t(1) << 32) + 16);
+    std::unique_ptr<CircularBuffer> cb;
+    try {
+        cb.reset(new CircularBuffer(capacity));
+    } catch (const std::bad_alloc&) {
+        GTEST_SKIP() << "cannot reserve address space for 2^32 elements";
+    }
+    EXPECT_EQ(cb->capacity(), capacity);
+    EXPECT_EQ(cb->reserve(), capacity);
+
+    cb->push_back(1);
+    cb->push_back(2);
+    // Голова уходит на индекс capacity - 1 > 2^32
+    cb->push_front(0);
+    EXPECT_EQ(cb->size(), 3);
+    EXPECT_EQ(cb->front(), 0);
+    EXPECT_EQ(cb->at(1), 1);
+    EXPECT_EQ((*cb)[2], 2);
+    EXPECT_EQ(cb->back(), 2);
+    EXPECT_FALSE(cb->is_linearized());
+
+    SegmentPair<const value_type> parts = static_cast<const CircularBuffer&>(*cb).segments();
+    EXPECT_EQ(parts.first.size, 1);
+    EXPECT_EQ(parts.second.size, 2);
+
+    cb->pop_front();
+    EXPECT_EQ(cb->front(), 1);
+    EXPECT_TRUE(cb->is_linearized());
+}
+
+// === Тесты для встроенного хранилища (small-buffer optimization) ===
+// Маленькие буферы хранятся внутри объекта, большие - в куче
+TEST(CircularBufferTest_Inline, SmallCapacityIsInline) {
+    CircularBuffer small(CircularBuffer::inline_capacity);
+    EXPECT_TRUE(small.is_inline());
+
+    CircularBuffer large(CircularBuffer::inline_capacity + 1);
+    EXPECT_FALSE(large.is_inline());
+}
+
+// set_capacity переносит данные в кучу и обратно с сохранением порядка
+TEST(CircularBufferTest_Inline, SetCapacitySpillsAndReturns) {
+    CircularBuffer cb(4);
+    for (int i = 1; i <= 6; ++i) {
+        cb.push_back(i * 10); // переполнение: голова не в нуле
+    }
+
+    cb.set_capacity(CircularBuffer::inline_capacity * 2);
+    EXPECT_FALSE(cb.is_inline());
+    ASSERT_EQ(cb.size(), 4);
+    EXPECT_EQ(cb[0], 30);
+    EXPECT_EQ(cb[3], 60);
+
+    cb.set_capacity(4);
+    EXPECT_TRUE(cb.is_inline());
+    EXPECT_TRUE(cb.full());
+    EXPECT_EQ(cb[0], 30);
+    EXPECT_EQ(cb[3], 60);
+
+    cb.push_back(70);
+    EXPECT_EQ(cb.front(), 40);
+    EXPECT_EQ(cb.back(), 70);
+}
+
+// swap и перемещение для разных представлений
+TEST(CircularBufferTest_Inline, SwapMixedStorage) {
+    CircularBuffer small(3);
+    small.push_back(1);
+    small.push_back(2);
+
+    CircularBuffer large(CircularBuffer::inline_capacity + 5);
+    large.push_back(7);
+
+    small.swap(large);
+    EXPECT_FALSE(small.is_inline());
+    EXPECT_EQ(small.size(), 1);
+    EXPECT_EQ(small[0], 7);
+    EXPECT_TRUE(large.is_inline());
+    EXPECT_EQ(large.capacity(), 3);
+    EXPECT_EQ(large[0], 1);
+    EXPECT_EQ(large[1], 2);
+}
+
+TEST(CircularBufferTest_Inline, MoveAndCopy) {
+    CircularBuffer large(CircularBuffer::inline_capacity + 1, 5);
+    CircularBuffer moved(std::move(large));
+    EXPECT_EQ(moved.size(), CircularBuffer::inline_capacity + 1);
+    EXPECT_EQ(large.capacity(), 0);
+
+    CircularBuffer copy(moved);
+    copy[0] = 9;
+    EXPECT_EQ(moved[0], 5); // копия не разделяет память с оригиналом
+
+    CircularBuffer small(2, 3);
+    moved = std::move(small);
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_EQ(moved[1], 3);
+}
+
+// === Тесты для копирования при записи (copy-on-write) ===
+// Копия разделяет память до первого изменения
+TEST(CircularBufferTest_CopyOnWrite, CopySharesUntilMutation) {
+    const int capacity = CircularBuffer::inline_capacity * 4;
+    CircularBuffer original(capacity);
+    for (int i = 0; i < capacity + 3; ++i) {
+        original.push_back(i);
+    }
+
+    CircularBuffer snapshot(original);
+    EXPECT_TRUE(original.is_shared());
+    EXPECT_TRUE(snapshot.is_shared());
+    EXPECT_TRUE(snapshot == original);
+
+    original.push_back(1000); // первое изменение отделяет оригинал
+    EXPECT_FALSE(original.is_shared());
+    EXPECT_FALSE(snapshot.is_shared());
+    EXPECT_EQ(snapshot.back(), capacity + 2);
+    EXPECT_EQ(snapshot.front(), 3);
+    EXPECT_EQ(original.back(), 1000);
+    EXPECT_EQ(original.front(), 4);
+}
+
+// Изменение через operator[] и insert у копии не видно оригиналу
+TEST(CircularBufferTest_CopyOnWrite, WritesThroughAccessorsDetach) {
+    CircularBuffer original(CircularBuffer::inline_capacity + 8);
+    for (int i = 0; i < 10; ++i) {
+        original.push_back(i);
+    }
+
+    // Чтение через константную ссылку не мешает разделению памяти
+    const CircularBuffer& view = original;
+    CircularBuffer copy;
+    copy = original;
+    EXPECT_TRUE(copy.is_shared());
+    copy[0] = 42;
+    EXPECT_EQ(view[0], 0);
+    EXPECT_EQ(copy[0], 42);
+
+    CircularBuffer second(original);
+    second.insert(1, 7);
+    EXPECT_EQ(second.size(), 11);
+    EXPECT_EQ(second[1], 7);
+    EXPECT_EQ(second[2], 1);
+    EXPECT_EQ(view.size(), 10);
+    EXPECT_EQ(view[1], 1);
+
+    // pop не меняет данные и не требует копирования
+    CircularBuffer third(original);
+    third.pop_front();
+    EXPECT_TRUE(third.is_shared());
+    EXPECT_EQ(third.front(), 1);
+    EXPECT_EQ(view.front(), 0);
+}
+
+// Запись через ссылку, полученную до копирования, не попадает в копию
+TEST(CircularBufferTest_CopyOnWrite, EscapedReferenceDisablesSharing) {
+    CircularBuffer original(CircularBuffer::inline_capacity * 2);
+    for (int i = 0; i < 20; ++i) {
+        original.push_back(i);
+    }
+    value_type& first = original[0];
+    const CircularBuffer snapshot(original);
+    EXPECT_FALSE(original.is_shared());
+    EXPECT_FALSE(snapshot.is_shared());
+    first = 42;
+    EXPECT_EQ(snapshot[0], 0);
+    EXPECT_EQ(original[0], 42);
+
+    // То же для указателя из linearize() на обёрнутом буфере
+    CircularBuffer ring(CircularBuffer::inline_capacity * 2);
+    for (int i = 0; i < 40; ++i) {
+        ring.push_back(i);
+    }
+    value_type* data = ring.linearize();
+    CircularBuffer copy(ring);
+    data[1] = -1;
+    EXPECT_EQ(copy[1], 9);
+    EXPECT_EQ(copy.front(), 8);
+    EXPECT_EQ(copy.back(), 39);
+    EXPECT_EQ(ring[1], -1);
+}
+
 // === Тесты для провальных сценариев ===
 TEST(CircularBufferTest_Failures, IncorrectAccess) {
     CircularBuffer cb(5);
@@ -258,6 +720,19 @@ TEST(CircularBufferTest_Invalid, NegativeCapacity) {
     EXPECT_THROW(CircularBuffer(-1), std::invalid_argument);
 }
 
+// Размер памяти для огромной ёмкости переполнил бы size_t
+TEST(CircularBufferTest_Invalid, CapacityOverflow) {
+    if (sizeof(size_type) < sizeof(std::size_t)) {
+        GTEST_SKIP() << "size_type cannot overflow the storage size";
+    }
+    const size_type huge = std::numeric_limits<size_type>::max() / 2;
+    EXPECT_THROW(CircularBuffer cb_huge(huge), std::length_error);
+    EXPECT_THROW(CircularBuffer(std::numeric_limits<size_type>::max()), std::length_error);
+    CircularBuffer cb(4);
+    EXPECT_THROW(cb.set_capacity(huge), std::length_error);
+    EXPECT_EQ(cb.capacity(), 4);
+}
+
 TEST(CircularBufferTest_Invalid, OutOfRangeAccess) {
     CircularBuffer cb(5);
     cb.push_back(10);
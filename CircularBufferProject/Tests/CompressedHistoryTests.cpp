@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include <climits>
+#include <random>
+#include <vector>
+#include "../Compressed_History_Buffer.h"
+
+// Медленно меняющийся счетчик восстанавливается без потерь
+TEST(CompressedHistoryBufferTest, RoundTripRandomWalk) {
+    CompressedHistoryBuffer history(20000);
+    std::vector<value_type> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> step(-3, 3);
+
+    value_type v = 100000;
+    for (int i = 0; i < 50000; ++i) {
+        v += step(gen);
+        history.push_back(v);
+        reference.push_back(v);
+    }
+
+    // Вытесняются целые блоки, хранится не меньше заявленной емкости
+    EXPECT_GE(history.size(), 20000);
+    EXPECT_LE(history.size(), history.capacity());
+    EXPECT_EQ(history.size() % CompressedHistoryBuffer::block_size, 50000 % CompressedHistoryBuffer::block_size);
+
+    std::vector<value_type> decoded(history.size());
+    history.read(0, history.size(), decoded.data());
+    std::vector<value_type> expected(reference.end() - history.size(), reference.end());
+    EXPECT_EQ(decoded, expected);
+    EXPECT_EQ(history.at(history.size() - 1), v);
+
+    // 3 бита на дельту вместо 32 бит на значение
+    std::size_t raw = history.size() * sizeof(value_type);
+    EXPECT_LT(history.memory_bytes() * 4, raw);
+}
+
+// Узкие блоки на месте широких не уменьшают учтенную память
+TEST(CompressedHistoryBufferTest, MemoryBytesCoversReusedArena) {
+    CompressedHistoryBuffer history(4096);
+    std::mt19937 gen(7);
+    for (int i = 0; i < 4096; ++i) {
+        history.push_back(static_cast<value_type>(gen()));
+    }
+    // Полная ширина: арена вмещает все блоки по 32 бита на дельту
+    std::size_t wide = history.memory_bytes();
+    EXPECT_GE(wide, 4096 * sizeof(value_type));
+
+    std::vector<value_type> reference;
+    for (int i = 0; i < 8192; ++i) {
+        history.push_back(i / 16);
+        reference.push_back(i / 16);
+    }
+    EXPECT_EQ(history.memory_bytes(), wide);
+
+    std::vector<value_type> decoded(history.size());
+    history.read(0, history.size(), decoded.data());
+    EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), reference.end() - history.size()));
+}
+
+// Крайние значения и чтение с середины блока
+TEST(CompressedHistoryBufferTest, ExtremeValuesAndPartialReads) {
+    CompressedHistoryBuffer history(256);
+    std::vector<value_type> reference;
+    for (int i = 0; i < 300; ++i) {
+        value_type v = (i % 2) ? INT_MAX : INT_MIN;
+        if (i % 7 == 0) v = i;
+        history.push_back(v);
+        reference.push_back(v);
+    }
+    ASSERT_EQ(history.size(), 300);
+
+    std::vector<value_type> part(150);
+    history.read(70, 150, part.data());
+    EXPECT_TRUE(std::equal(part.begin(), part.end(), reference.begin() + 70));
+
+    EXPECT_THROW(history.at(300), std::out_of_range);
+    EXPECT_THROW(history.read(200, 101, part.data()), std::out_of_range);
+
+    history.clear();
+    EXPECT_TRUE(history.empty());
+}
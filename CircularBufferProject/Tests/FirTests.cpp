@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../Fir_Filter.h"
+
+// Наивная свёртка для сравнения
+static std::vector<float> naive(const std::vector<float>& taps, const std::vector<int>& x) {
+    std::vector<float> y(x.size());
+    for (size_t n = 0; n < x.size(); n++) {
+        float sum = 0;
+        for (size_t j = 0; j < taps.size() && j <= n; j++) {
+            sum += taps[j] * x[n - j];
+        }
+        y[n] = sum;
+    }
+    return y;
+}
+
+// Потоковый режим совпадает с прямой свёрткой
+TEST(FirFilterTest, StreamingMatchesNaive) {
+    std::vector<float> taps = {0.5f, 0.25f, -0.125f, 1.0f, 2.0f};
+    std::vector<int> x;
+    for (int i = 0; i < 50; i++) {
+        x.push_back((i * 37) % 11 - 5);
+    }
+    std::vector<float> expected = naive(taps, x);
+    FirFilter fir(taps);
+    for (size_t i = 0; i < x.size(); i++) {
+        EXPECT_FLOAT_EQ(fir.push(x[i]), expected[i]);
+    }
+    fir.reset();
+    EXPECT_FLOAT_EQ(fir.push(2), 1.0f);
+    EXPECT_THROW(FirFilter(std::vector<float>()), std::invalid_argument);
+}
+
+// Блочный режим даёт тот же результат, что и поэлементный, в том числе по сегментам кольца
+TEST(FirFilterTest, BlockMatchesStreaming) {
+    std::vector<float> taps(37);
+    for (size_t i = 0; i < taps.size(); i++) {
+        taps[i] = 1.0f / (1 + i);
+    }
+    CircularBuffer cb(64);
+    for (int i = 0; i < 100; i++) {
+        cb.push_back(i % 7);
+    }
+
+    FirFilter stream(taps);
+    std::vector<float> expected;
+    for (int i = 0; i < cb.size(); i++) {
+        expected.push_back(stream.push(cb[i]));
+    }
+
+    FirFilter block(taps);
+    std::vector<float> out(cb.size());
+    size_type done = 0;
+    cb.consume(10, [&](const value_type* data, size_type n) {
+        block.process(data, n, out.data() + done);
+        done += n;
+    });
+    cb.consume_all([&](const value_type* data, size_type n) {
+        block.process(data, n, out.data() + done);
+        done += n;
+    });
+    ASSERT_EQ(done, 64);
+    for (size_t i = 0; i < out.size(); i++) {
+        EXPECT_NEAR(out[i], expected[i], 1e-4);
+    }
+    // После блока потоковый режим продолжает ту же историю
+    EXPECT_NEAR(block.push(3), stream.push(3), 1e-4);
+}
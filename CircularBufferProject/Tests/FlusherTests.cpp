@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../Async_Flusher.h"
+
+static std::vector<int> read_all(int fd) {
+    std::vector<int> result;
+    int value;
+    lseek(fd, 0, SEEK_SET);
+    while (read(fd, &value, sizeof(value)) == sizeof(value)) {
+        result.push_back(value);
+    }
+    return result;
+}
+
+// Все записи попадают в файл в порядке поступления
+TEST(AsyncFlusherTest, WritesInOrder) {
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    int fd = fileno(file);
+    {
+        AsyncFlusher flusher(fd, 64, 16, std::chrono::milliseconds(100));
+        for (int i = 0; i < 1000; i++) {
+            flusher.push(i);
+            if (i % 100 == 0) {
+                flusher.flush();
+            }
+        }
+        flusher.flush();
+        EXPECT_EQ(flusher.dropped() + flusher.written(), 1000u);
+        EXPECT_FALSE(flusher.error());
+    }
+    std::vector<int> data = read_all(fd);
+    // При переполнении теряются старейшие записи, порядок сохраняется
+    for (size_t i = 1; i < data.size(); i++) {
+        ASSERT_LT(data[i - 1], data[i]);
+    }
+    EXPECT_EQ(data.back(), 999);
+    fclose(file);
+}
+
+// Неполная пачка записывается по истечении предельной задержки
+TEST(AsyncFlusherTest, LatencyBound) {
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    int fd = fileno(file);
+    AsyncFlusher flusher(fd, 1024, 1000, std::chrono::milliseconds(5));
+    flusher.push(7);
+    flusher.push(8);
+    flusher.push(9);
+    for (int i = 0; i < 200 && flusher.written() < 3; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(flusher.written(), 3u);
+    EXPECT_EQ(read_all(fd), (std::vector<int>{7, 8, 9}));
+    fclose(file);
+}
+
+// Медленный приёмник не блокирует производителя, лишние записи считаются потерянными
+TEST(AsyncFlusherTest, SlowSinkDropsOldest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const int total = 100000;
+    size_t bytes = 0;
+    std::thread reader;
+    std::uint64_t dropped = 0;
+    {
+        AsyncFlusher flusher(fds[1], 1024, 256, std::chrono::milliseconds(1));
+        // Канал никто не читает, поэтому запись встаёт, когда он заполнится
+        for (int i = 0; i < total; i++) {
+            flusher.push(i);
+        }
+        dropped = flusher.dropped();
+        EXPECT_GT(dropped, 0u);
+        reader = std::thread([&]() {
+            char chunk[4096];
+            ssize_t n;
+            while ((n = read(fds[0], chunk, sizeof(chunk))) > 0) {
+                bytes += n;
+            }
+        });
+        flusher.flush();
+        EXPECT_EQ(flusher.dropped() + flusher.written(), static_cast<std::uint64_t>(total));
+    }
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+    EXPECT_EQ(bytes % sizeof(int), 0u);
+    EXPECT_EQ(bytes / sizeof(int) + dropped, static_cast<size_t>(total));
+}
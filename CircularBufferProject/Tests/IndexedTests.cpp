@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "../Indexed_Circular_Buffer.h"
+
+// Точный индекс следит за окном при вытеснении и удалении
+TEST(IndexedCircularBufferTest, ExactWindow) {
+    IndexedCircularBuffer window(4);
+    window.push_back(1);
+    window.push_back(2);
+    window.push_back(1);
+    EXPECT_TRUE(window.contains(1));
+    EXPECT_EQ(window.count(1), 2);
+    EXPECT_FALSE(window.contains(3));
+
+    window.push_back(3);
+    window.push_back(4);
+    // Первая единица вытеснена
+    EXPECT_EQ(window.count(1), 1);
+    window.push_back(5);
+    EXPECT_FALSE(window.contains(2));
+
+    window.pop_front();
+    EXPECT_FALSE(window.contains(1));
+    window.pop_back();
+    EXPECT_FALSE(window.contains(5));
+    EXPECT_EQ(window.size(), 2);
+    EXPECT_EQ(window.ring().front(), 3);
+
+    window.clear();
+    EXPECT_FALSE(window.contains(3));
+    EXPECT_THROW(window.pop_front(), std::out_of_range);
+}
+
+// Счётный фильтр Блума не даёт ложных отрицаний и редко ошибается в другую сторону
+TEST(IndexedCircularBufferTest, CountingBloom) {
+    IndexedCircularBuffer window(1000, IndexMode::CountingBloom);
+    for (int i = 0; i < 5000; i++) {
+        window.push_back(i);
+    }
+    for (int i = 4000; i < 5000; i++) {
+        ASSERT_TRUE(window.contains(i));
+        EXPECT_GE(window.count(i), 1);
+    }
+    int false_positives = 0;
+    for (int i = 0; i < 4000; i++) {
+        false_positives += window.contains(i);
+    }
+    EXPECT_LT(false_positives, 200);
+
+    window.clear();
+    EXPECT_FALSE(window.contains(4500));
+    EXPECT_THROW(IndexedCircularBuffer(10, IndexMode::CountingBloom, 0, 0), std::invalid_argument);
+}
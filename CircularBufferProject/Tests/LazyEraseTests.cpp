@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../Lazy_Erase_Buffer.h"
+
+// Удаление из середины не сдвигает элементы, индексация пропускает надгробия
+TEST(LazyEraseBufferTest, EraseMarksDead) {
+    LazyEraseBuffer lb(200);
+    lb.set_compaction_threshold(0.9);
+    for (int i = 0; i < 150; i++) {
+        lb.push_back(i);
+    }
+    value_type* address = &lb[100];
+    lb.erase(10, 60);
+    EXPECT_EQ(lb.size(), 100);
+    EXPECT_EQ(lb.slots(), 150);
+    EXPECT_EQ(lb.dead(), 50);
+    EXPECT_EQ(&lb[50], address);
+    EXPECT_EQ(lb[9], 9);
+    EXPECT_EQ(lb[10], 60);
+    EXPECT_EQ(lb.at(99), 149);
+    EXPECT_THROW(lb.at(100), std::out_of_range);
+
+    std::vector<int> seen;
+    lb.for_each([&seen](value_type& v) { seen.push_back(v); });
+    ASSERT_EQ(seen.size(), 100u);
+    EXPECT_EQ(seen[10], 60);
+
+    // Надгробия на краях освобождаются сразу
+    lb.erase(0, 10);
+    EXPECT_EQ(lb.dead(), 0);
+    EXPECT_EQ(lb.front(), 60);
+
+    // Заполнение слотов вызывает уплотнение, а не перезапись живых элементов
+    lb.erase(1, 3);
+    for (int i = 0; i < 110; i++) {
+        lb.push_back(1000 + i);
+    }
+    EXPECT_EQ(lb.slots(), 200);
+    EXPECT_EQ(lb.dead(), 2);
+    lb.push_back(1110);
+    EXPECT_EQ(lb.size(), 199);
+    EXPECT_EQ(lb.dead(), 0);
+    EXPECT_EQ(lb.front(), 60);
+    EXPECT_EQ(lb[1], 63);
+    EXPECT_EQ(lb.back(), 1110);
+}
+
+// Случайные операции совпадают с моделью на std::vector
+TEST(LazyEraseBufferTest, MatchesModel) {
+    const int capacity = 300;
+    LazyEraseBuffer lb(capacity);
+    std::vector<int> model;
+    unsigned state = 777;
+    auto next = [&state]() { state = state * 1103515245u + 12345u; return state >> 16; };
+    for (int step = 0; step < 20000; step++) {
+        int op = next() % 10;
+        if (op < 5) {
+            lb.push_back(step);
+            if (static_cast<int>(model.size()) == capacity) {
+                model.erase(model.begin());
+            }
+            model.push_back(step);
+        } else if (op == 5 && !model.empty()) {
+            lb.pop_front();
+            model.erase(model.begin());
+        } else if (op == 6 && !model.empty()) {
+            lb.pop_back();
+            model.pop_back();
+        } else if (!model.empty()) {
+            int first = next() % model.size();
+            int last = first + 1 + next() % std::min<int>(5, model.size() - first);
+            lb.erase(first, last);
+            model.erase(model.begin() + first, model.begin() + last);
+        }
+        ASSERT_EQ(lb.size(), static_cast<size_type>(model.size()));
+        if (!model.empty()) {
+            int i = next() % model.size();
+            ASSERT_EQ(lb[i], model[i]);
+            ASSERT_EQ(lb.front(), model.front());
+            ASSERT_EQ(lb.back(), model.back());
+        }
+    }
+    lb.compact();
+    EXPECT_EQ(lb.dead(), 0);
+    for (size_t i = 0; i < model.size(); i++) {
+        ASSERT_EQ(lb[i], model[i]);
+    }
+}
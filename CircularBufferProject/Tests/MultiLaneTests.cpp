@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../Multi_Lane_Queue.h"
+
+// Строгий приоритет: младшие полосы обслуживаются первыми
+TEST(MultiLaneQueueTest, StrictPriority) {
+    MultiLaneQueue q(3, 8, LanePolicy::StrictPriority);
+    q.push(2, 200);
+    q.push(0, 1);
+    q.push(1, 10);
+    q.push(0, 2);
+    EXPECT_EQ(q.occupancy(), 0b111u);
+
+    value_type out[8];
+    int lanes[8];
+    ASSERT_EQ(q.pop_batch(out, 3, lanes), 3);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(out[2], 10);
+    EXPECT_EQ(lanes[2], 1);
+    EXPECT_EQ(q.occupancy(), 0b100u);
+
+    ASSERT_EQ(q.pop_batch(out, 8), 1);
+    EXPECT_EQ(out[0], 200);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.pop_batch(out, 8), 0);
+}
+
+// Deficit round robin делит поток пропорционально весам
+TEST(MultiLaneQueueTest, DeficitRoundRobinShares) {
+    MultiLaneQueue q(3, 1000);
+    q.set_weight(0, 4);
+    q.set_weight(1, 2);
+    q.set_weight(2, 1);
+    for (int i = 0; i < 500; ++i) {
+        q.push(0, i);
+        q.push(1, i);
+        q.push(2, i);
+    }
+
+    std::vector<int> served(3, 0);
+    value_type out[7];
+    int lanes[7];
+    for (int round = 0; round < 100; ++round) {
+        int n = q.pop_batch(out, 5, lanes); // размер пакета не кратен раунду
+        for (int i = 0; i < n; ++i) served[lanes[i]]++;
+    }
+    EXPECT_EQ(served[0] + served[1] + served[2], 500);
+    EXPECT_NEAR(served[0], 500 * 4 / 7, 4);
+    EXPECT_NEAR(served[1], 500 * 2 / 7, 4);
+    EXPECT_NEAR(served[2], 500 / 7, 4); // нижняя полоса не голодает
+
+    // Порядок внутри полосы сохраняется
+    q.pop_batch(out, 7, lanes);
+    for (int i = 1; i < 7; ++i) {
+        if (lanes[i] == lanes[i - 1]) {
+            EXPECT_EQ(out[i], out[i - 1] + 1);
+        }
+    }
+}
+
+// Пустые полосы пропускаются, доля пустой полосы не накапливается
+TEST(MultiLaneQueueTest, SkipsEmptyLanes) {
+    MultiLaneQueue q(64, 4);
+    q.push(63, 7);
+    q.push(5, 3);
+    EXPECT_EQ(q.size(), 2);
+
+    value_type out[4];
+    int lanes[4];
+    ASSERT_EQ(q.pop_batch(out, 4, lanes), 2);
+    EXPECT_EQ(lanes[0], 5);
+    EXPECT_EQ(lanes[1], 63);
+
+    EXPECT_TRUE(q.try_push(1, 1));
+    for (int i = 0; i < 3; ++i) q.push(1, i);
+    EXPECT_FALSE(q.try_push(1, 9));
+    EXPECT_THROW(q.push(64, 1), std::out_of_range);
+    EXPECT_THROW(MultiLaneQueue(65, 4), std::invalid_argument);
+    EXPECT_THROW(q.set_weight(0, 0), std::invalid_argument);
+    EXPECT_THROW(q.weight(64), std::out_of_range);
+    EXPECT_THROW(q.size(-1), std::out_of_range);
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "../Parallel_Algorithms.h"
+
+// Буфер с головой в середине массива, чтобы куски пересекали границу
+static CircularBuffer make_wrapped(int capacity) {
+    CircularBuffer cb(capacity);
+    for (int i = 0; i < capacity + capacity / 3; ++i) {
+        cb.push_back((i * 7919) % 10007 - 5000);
+    }
+    return cb;
+}
+
+static std::vector<value_type> to_vector(const CircularBuffer& cb) {
+    std::vector<value_type> out;
+    for (int i = 0; i < cb.size(); ++i) out.push_back(cb[i]);
+    return out;
+}
+
+TEST(ParallelAlgorithmsTest, ReduceMatchesSequential) {
+    CircularBuffer cb = make_wrapped(100000);
+    ASSERT_FALSE(cb.is_linearized());
+    std::vector<value_type> values = to_vector(cb);
+
+    long long expected = std::accumulate(values.begin(), values.end(), 0LL);
+    EXPECT_EQ(parallel_reduce(cb, 0LL, std::plus<long long>(), 4), expected);
+    EXPECT_EQ(parallel_reduce(cb, 0LL, std::plus<long long>(), 1), expected);
+
+    double squares = parallel_transform_reduce(cb, 0.0, std::plus<double>(),
+        [](const value_type& v) { return static_cast<double>(v) * v; }, 3);
+    double expected_squares = 0;
+    for (value_type v : values) expected_squares += static_cast<double>(v) * v;
+    EXPECT_DOUBLE_EQ(squares, expected_squares);
+
+    // Порядок кусков сохраняется: некоммутативная операция "взять первый"
+    value_type first = parallel_transform_reduce(cb, values[0],
+        [](value_type a, value_type) { return a; }, [](const value_type& v) { return v; }, 4);
+    EXPECT_EQ(first, values[0]);
+
+    CircularBuffer empty(10);
+    EXPECT_EQ(parallel_reduce(empty, 5LL), 5);
+}
+
+TEST(ParallelAlgorithmsTest, ForEachTouchesEveryElementOnce) {
+    CircularBuffer cb = make_wrapped(70000);
+    std::vector<value_type> values = to_vector(cb);
+    parallel_for_each(cb, [](value_type& v) { v += 1; }, 4);
+    for (int i = 0; i < cb.size(); ++i) {
+        ASSERT_EQ(cb[i], values[i] + 1);
+    }
+}
+
+TEST(ParallelAlgorithmsTest, SortWrappedBuffer) {
+    CircularBuffer cb = make_wrapped(90001);
+    std::vector<value_type> values = to_vector(cb);
+    std::sort(values.begin(), values.end());
+
+    parallel_sort(cb, std::less<value_type>(), 5);
+    EXPECT_EQ(to_vector(cb), values);
+
+    parallel_sort(cb, std::greater<value_type>(), 2);
+    EXPECT_EQ(cb.front(), values.back());
+    EXPECT_EQ(cb.back(), values.front());
+}
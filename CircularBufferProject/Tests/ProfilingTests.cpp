@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include <sstream>
+#include "../Circular_Buffer.h"
+#include "../Latency_Histogram.h"
+
+// Перцентили с точностью до ширины подкорзины (~3%)
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.percentile(99), 0u);
+
+    for (std::uint64_t v = 1; v <= 10000; ++v) {
+        h.record(v);
+    }
+    EXPECT_EQ(h.count(), 10000u);
+    EXPECT_EQ(h.max(), 10000u);
+    EXPECT_DOUBLE_EQ(h.mean(), 5000.5);
+    EXPECT_NEAR(static_cast<double>(h.percentile(50)), 5000, 5000 * 0.04);
+    EXPECT_NEAR(static_cast<double>(h.percentile(99)), 9900, 9900 * 0.04);
+    EXPECT_EQ(h.percentile(100), 10000u);
+
+    h.record(1000000000ull);
+    EXPECT_EQ(h.percentile(100), 1000000000ull);
+    EXPECT_NEAR(static_cast<double>(h.percentile(99.9)), 10000, 10000 * 0.04);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram h;
+    for (int i = 0; i < 90; ++i) h.record(3);
+    for (int i = 0; i < 10; ++i) h.record(17);
+    EXPECT_EQ(h.percentile(90), 3u);
+    EXPECT_EQ(h.percentile(91), 17u);
+
+    std::ostringstream out;
+    h.dump(out);
+    EXPECT_NE(out.str().find("count=100"), std::string::npos);
+}
+
+#ifdef CB_PROFILING
+// Профилирующая сборка собирает выборку по операциям
+TEST(OperationProfilerTest, SamplesOperations) {
+    OperationProfiler::reset();
+    OperationProfiler::set_sample_rate(4);
+
+    CircularBuffer cb(100);
+    for (int i = 0; i < 400; ++i) {
+        cb.push_back(i);
+    }
+    EXPECT_EQ(OperationProfiler::histogram(ProfiledOp::PushBack).count(), 100u);
+
+    OperationProfiler::set_sample_rate(1);
+    cb.set_capacity(200);
+    EXPECT_EQ(OperationProfiler::histogram(ProfiledOp::SetCapacity).count(), 1u);
+
+    std::ostringstream out;
+    OperationProfiler::dump(out);
+    EXPECT_NE(out.str().find("push_back: count="), std::string::npos);
+    EXPECT_THROW(OperationProfiler::set_sample_rate(0), std::invalid_argument);
+    OperationProfiler::set_sample_rate(64);
+}
+#endif
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "../Ring_Pool.h"
+
+// Кольца из одного пула независимы и ведут себя как CircularBuffer
+TEST(RingPoolTest, IndependentRings) {
+    RingPool pool;
+    std::vector<RingHandle> rings;
+    for (int i = 0; i < 100; i++) {
+        rings.push_back(pool.create(3));
+    }
+    EXPECT_EQ(RingPool::capacity(rings[0]), 4);
+    EXPECT_EQ(pool.rings(), 100);
+
+    // Рост общего массива не ломает ранее созданные кольца
+    for (int round = 0; round < 6; round++) {
+        for (int i = 0; i < 100; i++) {
+            pool.push_back(rings[i], i * 100 + round);
+        }
+    }
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(RingPool::full(rings[i]));
+        EXPECT_EQ(pool.front(rings[i]), i * 100 + 2);
+        EXPECT_EQ(pool.back(rings[i]), i * 100 + 5);
+        EXPECT_EQ(pool.at(rings[i], 1), i * 100 + 3);
+    }
+
+    SegmentPair<value_type> parts = pool.segments(rings[7]);
+    EXPECT_EQ(parts.first.size, 2);
+    EXPECT_EQ(parts.second.size, 2);
+    EXPECT_EQ(parts.second[0], 704);
+
+    pool.pop_front(rings[7]);
+    pool.pop_back(rings[7]);
+    EXPECT_EQ(RingPool::size(rings[7]), 2);
+    EXPECT_EQ(pool.front(rings[7]), 703);
+    EXPECT_THROW(pool.at(rings[7], 2), std::out_of_range);
+}
+
+// Освобождённая память переиспользуется кольцами того же класса
+TEST(RingPoolTest, ReuseAndLimits) {
+    EXPECT_EQ(sizeof(RingHandle), 8u);
+
+    RingPool pool;
+    RingHandle a = pool.create(16);
+    RingHandle b = pool.create(16);
+    std::size_t bytes = pool.memory_bytes();
+    std::uint32_t slot = a.slot;
+    pool.destroy(a);
+    EXPECT_EQ(pool.rings(), 1);
+    RingHandle c = pool.create(9);
+    EXPECT_EQ(c.slot, slot);
+    EXPECT_EQ(pool.memory_bytes(), bytes);
+    EXPECT_TRUE(RingPool::empty(c));
+    EXPECT_THROW(pool.pop_front(b), std::out_of_range);
+
+    EXPECT_THROW(pool.create(0), std::invalid_argument);
+    EXPECT_THROW(pool.create(RingPool::max_capacity + 1), std::invalid_argument);
+    RingHandle big = pool.create(RingPool::max_capacity);
+    for (int i = 0; i < RingPool::max_capacity + 5; i++) {
+        pool.push_back(big, i);
+    }
+    EXPECT_EQ(RingPool::size(big), RingPool::max_capacity);
+    EXPECT_EQ(pool.front(big), 5);
+}
+
+// Нулевой дескриптор и повторное освобождение отвергаются и не портят живые кольца
+TEST(RingPoolTest, NullHandleRejected) {
+    RingPool pool;
+    RingHandle a = pool.create(1);
+    RingHandle b = pool.create(1);
+    pool.push_back(a, 5);
+    pool.destroy(b);
+    EXPECT_FALSE(b.valid());
+    EXPECT_THROW(pool.destroy(b), std::invalid_argument);
+    EXPECT_EQ(pool.rings(), 1);
+
+    RingHandle none{};
+    EXPECT_FALSE(none.valid());
+    EXPECT_THROW(pool.push_back(none, -7), std::invalid_argument);
+    EXPECT_THROW(pool.front(none), std::invalid_argument);
+    EXPECT_THROW(RingPool::capacity(none), std::invalid_argument);
+    EXPECT_TRUE(RingPool::empty(none));
+
+    RingHandle c = pool.create(1);
+    EXPECT_NE(c.slot, a.slot);
+    pool.push_back(c, -1);
+    EXPECT_EQ(pool.front(a), 5);
+    EXPECT_EQ(pool.rings(), 2);
+}
@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include <deque>
+#include "../Segmented_Queue.h"
+
+// Очередь растёт с обоих концов без копирования элементов
+TEST(SegmentedQueueTest, BothEnds) {
+    SegmentedQueue q(4);
+    for (int i = 0; i < 10; i++) {
+        q.push_back(i);
+    }
+    for (int i = 1; i <= 5; i++) {
+        q.push_front(-i);
+    }
+    ASSERT_EQ(q.size(), 15);
+    EXPECT_EQ(q.front(), -5);
+    EXPECT_EQ(q.back(), 9);
+    for (int i = 0; i < 15; i++) {
+        EXPECT_EQ(q[i], i - 5);
+    }
+    EXPECT_THROW(q.at(15), std::out_of_range);
+
+    // Элементы не переезжают при росте
+    value_type* address = &q[7];
+    for (int i = 10; i < 1000; i++) {
+        q.push_back(i);
+    }
+    EXPECT_EQ(&q[7], address);
+    EXPECT_EQ(q[7], 2);
+}
+
+// Освобождённые блоки переиспользуются, в запасе остаётся не больше max_spare_chunks
+TEST(SegmentedQueueTest, ChunksFollowOccupancy) {
+    SegmentedQueue q(8);
+    for (int i = 0; i < 64; i++) {
+        q.push_back(i);
+    }
+    EXPECT_EQ(q.chunks(), 8);
+    for (int i = 0; i < 60; i++) {
+        q.pop_front();
+    }
+    EXPECT_EQ(q.chunks(), 1);
+    EXPECT_EQ(q.spare_chunks(), SegmentedQueue::max_spare_chunks);
+    EXPECT_EQ(q.front(), 60);
+
+    for (int i = 0; i < 20; i++) {
+        q.push_back(i);
+    }
+    EXPECT_EQ(q.chunks(), 4);
+    EXPECT_EQ(q.spare_chunks(), 0);
+    EXPECT_EQ(q.size(), 24);
+    EXPECT_EQ(q.back(), 19);
+
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.chunks(), 0);
+    EXPECT_EQ(q.spare_chunks(), SegmentedQueue::max_spare_chunks);
+    q.shrink_to_fit();
+    EXPECT_EQ(q.spare_chunks(), 0);
+    EXPECT_THROW(q.pop_back(), std::out_of_range);
+    EXPECT_THROW(SegmentedQueue(6), std::invalid_argument);
+}
+
+// Случайная последовательность операций совпадает с std::deque
+TEST(SegmentedQueueTest, MatchesDeque) {
+    SegmentedQueue q(16);
+    std::deque<int> model;
+    unsigned state = 12345;
+    for (int step = 0; step < 20000; step++) {
+        state = state * 1103515245u + 12345u;
+        int op = (state >> 16) % 4;
+        if (op == 0) {
+            q.push_back(step);
+            model.push_back(step);
+        } else if (op == 1) {
+            q.push_front(step);
+            model.push_front(step);
+        } else if (!model.empty() && op == 2) {
+            q.pop_front();
+            model.pop_front();
+        } else if (!model.empty()) {
+            q.pop_back();
+            model.pop_back();
+        }
+        ASSERT_EQ(q.size(), static_cast<int>(model.size()));
+        if (!model.empty()) {
+            ASSERT_EQ(q.front(), model.front());
+            ASSERT_EQ(q.back(), model.back());
+        }
+    }
+    for (int i = 0; i < q.size(); i++) {
+        ASSERT_EQ(q[i], model[i]);
+    }
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Seqlock_Buffer.h"
+
+TEST(SeqlockBufferTest, LatestValues) {
+    SeqlockBuffer sb(4);
+    value_type out[8];
+    EXPECT_EQ(sb.snapshot(out, 8), 0);
+
+    for (int i = 1; i <= 6; ++i) {
+        sb.push_back(i * 10);
+    }
+    EXPECT_EQ(sb.pushed(), 6u);
+    EXPECT_EQ(sb.size(), 4);
+
+    ASSERT_EQ(sb.snapshot(out, 8), 4);
+    EXPECT_EQ(out[0], 30);
+    EXPECT_EQ(out[3], 60);
+
+    ASSERT_EQ(sb.snapshot(out, 2), 2);
+    EXPECT_EQ(out[0], 50);
+    EXPECT_EQ(out[1], 60);
+
+    EXPECT_THROW(SeqlockBuffer(0), std::invalid_argument);
+}
+
+// Читатели всегда получают непрерывную возрастающую последовательность
+TEST(SeqlockBufferTest, ConcurrentReadersSeeConsistentSnapshots) {
+    SeqlockBuffer sb(64);
+    const int total = 200000;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            value_type out[16];
+            while (!done.load(std::memory_order_acquire)) {
+                int k = sb.snapshot(out, 16);
+                for (int i = 1; i < k; ++i) {
+                    if (out[i] != out[i - 1] + 1) torn++;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < total; ++i) {
+        sb.push_back(i);
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    value_type last;
+    ASSERT_EQ(sb.snapshot(&last, 1), 1);
+    EXPECT_EQ(last, total - 1);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdint>
+#include <sched.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "../Shm_Ring_Buffer.h"
+
+TEST(ShmRingBufferTest, WriteReadWrapAround) {
+    ShmRingBuffer ring = ShmRingBuffer::create(8);
+    value_type in[6] = { 1, 2, 3, 4, 5, 6 };
+    value_type out[8];
+
+    EXPECT_EQ(ring.write(in, 6), 6);
+    EXPECT_EQ(ring.read(out, 4), 4);
+    EXPECT_EQ(out[3], 4);
+    EXPECT_EQ(ring.write(in, 6), 6); // переход через границу
+    EXPECT_EQ(ring.write(in, 6), 0); // кольцо заполнено
+    EXPECT_EQ(ring.size(), 8);
+
+    ASSERT_EQ(ring.read(out, 8), 8);
+    EXPECT_EQ(out[0], 5);
+    EXPECT_EQ(out[2], 1);
+    EXPECT_EQ(out[7], 6);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_THROW(ring.wait_readable(), std::logic_error);
+}
+
+// Вторая проекция того же сегмента по другому адресу видит те же данные
+TEST(ShmRingBufferTest, NamedSegmentIsPositionIndependent) {
+    std::string name = "/cb_test_" + std::to_string(getpid());
+    ShmRingBuffer::unlink(name);
+    ShmRingBuffer producer = ShmRingBuffer::create_named(name, 16);
+    ShmRingBuffer consumer = ShmRingBuffer::open_named(name);
+    ShmRingBuffer::unlink(name);
+
+    value_type in[3] = { 7, 8, 9 };
+    EXPECT_EQ(producer.write(in, 3), 3);
+    EXPECT_EQ(consumer.capacity(), 16);
+    value_type out[3];
+    ASSERT_EQ(consumer.read(out, 3), 3);
+    EXPECT_EQ(out[2], 9);
+    EXPECT_TRUE(producer.empty());
+
+    EXPECT_THROW(ShmRingBuffer::open_named(name), std::system_error);
+}
+
+// Повреждённый заголовок чужого сегмента отвергается при подключении
+TEST(ShmRingBufferTest, AttachRejectsCorruptHeader) {
+    ShmRingBuffer ring = ShmRingBuffer::create(8);
+    // Поля заголовка: magic, element_size (по 4 байта), capacity, data_offset (по 8 байт)
+    char* raw = static_cast<char*>(mmap(nullptr, 32, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd(), 0));
+    ASSERT_NE(raw, MAP_FAILED);
+    std::uint64_t* capacity = reinterpret_cast<std::uint64_t*>(raw + 8);
+    std::uint64_t* data_offset = reinterpret_cast<std::uint64_t*>(raw + 16);
+    const std::uint64_t good_capacity = *capacity;
+    const std::uint64_t good_offset = *data_offset;
+
+    *capacity = 0;
+    EXPECT_THROW(ShmRingBuffer::attach(dup(ring.fd())), std::system_error);
+    *capacity = UINT64_MAX / 2; // segment_size() переполнился бы
+    EXPECT_THROW(ShmRingBuffer::attach(dup(ring.fd())), std::system_error);
+    *capacity = good_capacity + 1;
+    EXPECT_THROW(ShmRingBuffer::attach(dup(ring.fd())), std::system_error);
+    *capacity = good_capacity;
+    *data_offset = std::uint64_t(1) << 40;
+    EXPECT_THROW(ShmRingBuffer::attach(dup(ring.fd())), std::system_error);
+    *data_offset = good_offset;
+
+    ShmRingBuffer peer = ShmRingBuffer::attach(dup(ring.fd()));
+    EXPECT_EQ(peer.capacity(), 8);
+    munmap(raw, 32);
+}
+
+// Передача данных между двумя процессами с замером пропускной способности
+TEST(ShmRingBufferTest, TwoProcessThroughput) {
+    const int total = 4000000;
+    const int batch = 256;
+    ShmRingBuffer ring = ShmRingBuffer::create(1 << 16, true);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Потребитель: проверяет непрерывность последовательности
+        std::vector<value_type> out(batch);
+        value_type expected = 0;
+        while (expected < total) {
+            int n = ring.read(out.data(), batch);
+            if (n == 0) {
+                ring.wait_readable();
+                continue;
+            }
+            for (int i = 0; i < n; ++i) {
+                if (out[i] != expected++) _exit(1);
+            }
+        }
+        _exit(0);
+    }
+
+    std::vector<value_type> in(batch);
+    value_type next = 0;
+    while (next < total) {
+        for (int i = 0; i < batch; ++i) in[i] = next + i;
+        int n = std::min(batch, total - next);
+        int sent = 0;
+        while (sent < n) {
+            int w = ring.write(in.data() + sent, n - sent);
+            if (w == 0) sched_yield();
+            sent += w;
+        }
+        next += n;
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    auto stop = std::chrono::steady_clock::now();
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cout << "[ shm ring ] " << total / seconds / 1e6 << " M elements/s between processes\n";
+}
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "../SoA_Circular_Buffer.h"
+
+typedef SoACircularBuffer<int, double, char> Records;
+
+static double column_sum(const SegmentPair<const double>& column) {
+    double sum = 0;
+    for (double v : column.first) sum += v;
+    for (double v : column.second) sum += v;
+    return sum;
+}
+
+// Запись строк и чтение отдельных столбцов
+TEST(SoACircularBufferTest, PushRowsAndScanColumn) {
+    Records cb(4);
+    for (int i = 1; i <= 6; ++i) {
+        cb.push_back(i, i * 0.5, static_cast<char>('a' + i));
+    }
+    EXPECT_TRUE(cb.full());
+    EXPECT_EQ(cb.row(0), std::make_tuple(3, 1.5, 'd'));
+    EXPECT_EQ(cb.get<0>(3), 6);
+
+    const Records& view = cb;
+    SegmentPair<const double> prices = view.column<1>();
+    EXPECT_EQ(prices.size(), 4);
+    EXPECT_FALSE(prices.second.empty()); // голова не в начале массива
+    EXPECT_DOUBLE_EQ(column_sum(prices), 1.5 + 2.0 + 2.5 + 3.0);
+
+    cb.pop_front();
+    cb.pop_back();
+    EXPECT_EQ(cb.size(), 2);
+    EXPECT_EQ(cb.get<2>(0), 'e');
+    EXPECT_THROW(cb.row(2), std::out_of_range);
+}
+
+// Пакетное добавление по столбцам с переходом через границу
+TEST(SoACircularBufferTest, ColumnWiseAppend) {
+    Records cb(5);
+    cb.push_back(std::make_tuple(0, 0.0, 'x'));
+
+    int ids[] = { 1, 2, 3, 4, 5, 6 };
+    double values[] = { 1, 2, 3, 4, 5, 6 };
+    char tags[] = { 'a', 'b', 'c', 'd', 'e', 'f' };
+
+    cb.append(3, ids, values, tags);
+    EXPECT_EQ(cb.size(), 4);
+    EXPECT_EQ(cb.get<0>(3), 3);
+
+    cb.append(3, ids + 3, values + 3, tags + 3); // вытесняет две записи
+    EXPECT_EQ(cb.size(), 5);
+    EXPECT_EQ(cb.row(0), std::make_tuple(2, 2.0, 'b'));
+    EXPECT_EQ(cb.row(4), std::make_tuple(6, 6.0, 'f'));
+
+    cb.append(6, ids, values, tags); // больше емкости: остаются последние 5
+    EXPECT_EQ(cb.row(0), std::make_tuple(2, 2.0, 'b'));
+    EXPECT_TRUE(cb.column<2>().second.empty());
+
+    cb.clear();
+    EXPECT_TRUE(cb.empty());
+}
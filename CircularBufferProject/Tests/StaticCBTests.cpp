@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "../Circular_Buffer.h"
+#include "../Static_Circular_Buffer.h"
+
+// Все операции доступны на этапе компиляции
+constexpr int static_buffer_checksum() {
+    StaticCircularBuffer<int, 4> cb;
+    for (int i = 1; i <= 6; ++i) {
+        cb.push_back(i); // 3 4 5 6
+    }
+    cb.pop_front();      // 4 5 6
+    cb.push_front(10);   // 10 4 5 6
+    cb.insert(2, 7);     // 4 7 5 6
+    cb.linearize();
+    return cb[0] * 1000 + cb[1] * 100 + cb[2] * 10 + cb.back();
+}
+static_assert(static_buffer_checksum() == 4756, "constexpr operations");
+
+constexpr bool static_buffer_wraps() {
+    StaticCircularBuffer<int, 3> cb(3, 1);
+    cb.push_back(2);
+    cb.push_back(3);
+    cb.erase(0, 1);
+    return cb.size() == 2 && cb.front() == 2 && cb.back() == 3 && !cb.is_linearized();
+}
+static_assert(static_buffer_wraps(), "non power-of-two wrap-around");
+
+// Общий код для динамического и статического буфера
+template <typename Buffer>
+void fill_and_check(Buffer& cb) {
+    for (int i = 0; i < 10; ++i) {
+        cb.push_back(i);
+    }
+    EXPECT_TRUE(cb.full());
+    EXPECT_EQ(cb.size(), 8);
+    EXPECT_EQ(cb.front(), 2);
+    EXPECT_EQ(cb.back(), 9);
+    EXPECT_EQ(cb.at(3), 5);
+    EXPECT_THROW(cb.at(8), std::out_of_range);
+
+    cb.rotate(2);
+    EXPECT_EQ(cb[0], 4);
+    cb.linearize();
+    EXPECT_TRUE(cb.is_linearized());
+    EXPECT_EQ(cb[7], 3);
+
+    cb.pop_back();
+    cb.pop_front();
+    EXPECT_EQ(cb.reserve(), 2);
+    cb.clear();
+    EXPECT_TRUE(cb.empty());
+    EXPECT_THROW(cb.pop_front(), std::out_of_range);
+}
+
+TEST(StaticCircularBufferTest, SameApiAsDynamic) {
+    typedef StaticCircularBuffer<int, 8> StaticHistory;
+    typedef CircularBuffer DynamicHistory;
+
+    StaticHistory s(8);
+    DynamicHistory d(8);
+    fill_and_check(s);
+    fill_and_check(d);
+}
+
+TEST(StaticCircularBufferTest, FixedCapacity) {
+    StaticCircularBuffer<int, 5> cb;
+    EXPECT_EQ(cb.capacity(), 5);
+    EXPECT_THROW((StaticCircularBuffer<int, 5>(4)), std::invalid_argument);
+    EXPECT_THROW(cb.set_capacity(6), std::invalid_argument);
+    EXPECT_THROW(cb.resize(6), std::invalid_argument);
+
+    cb.resize(3, 42);
+    EXPECT_EQ(cb.size(), 3);
+    EXPECT_EQ(cb[2], 42);
+}
+
+TEST(StaticCircularBufferTest, SwapAndCompare) {
+    StaticCircularBuffer<int, 4> a;
+    StaticCircularBuffer<int, 4> b;
+    a.push_back(1);
+    a.push_back(2);
+    b.push_front(3);
+
+    a.swap(b);
+    EXPECT_EQ(a.size(), 1);
+    EXPECT_EQ(a[0], 3);
+    EXPECT_EQ(b.size(), 2);
+    EXPECT_EQ(b[1], 2);
+
+    StaticCircularBuffer<int, 4> c;
+    c.push_back(3);
+    EXPECT_TRUE(a == c);
+    EXPECT_TRUE(a != b);
+}
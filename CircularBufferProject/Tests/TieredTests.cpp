@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "../Tiered_Buffer.h"
+
+// Вытесненные отсчёты сворачиваются по уровням
+TEST(TieredBufferTest, RollUp) {
+    TieredBuffer history(4);
+    history.add_tier(3, 2);
+    history.add_tier(2, 3);
+    for (int i = 1; i <= 20; i++) {
+        history.push_back(i);
+    }
+
+    // Сырые отсчёты: 17..20
+    ASSERT_EQ(history.raw().size(), 4);
+    EXPECT_EQ(history.raw().front(), 17);
+
+    // Первый уровень хранит пары (11,12), (13,14), (15,16)
+    ASSERT_EQ(history.size(0), 3);
+    EXPECT_EQ(history.at(0, 0).min, 11);
+    EXPECT_EQ(history.at(0, 0).max, 12);
+    EXPECT_EQ(history.at(0, 2).sum, 31);
+    EXPECT_EQ(history.at(0, 2).count, 2);
+    EXPECT_EQ(history.pending(0).count, 0);
+
+    // Второй уровень: агрегат 1..6 и незавершённый 7..10
+    ASSERT_EQ(history.size(1), 1);
+    EXPECT_EQ(history.at(1, 0).min, 1);
+    EXPECT_EQ(history.at(1, 0).max, 6);
+    EXPECT_EQ(history.at(1, 0).count, 6);
+    EXPECT_DOUBLE_EQ(history.at(1, 0).avg(), 3.5);
+    EXPECT_EQ(history.pending(1).min, 7);
+    EXPECT_EQ(history.pending(1).max, 10);
+    EXPECT_EQ(history.pending(1).sum, 34);
+    EXPECT_THROW(history.at(1, 1), std::out_of_range);
+    EXPECT_THROW(history.size(history.tiers()), std::out_of_range);
+    EXPECT_THROW(history.size(-1), std::out_of_range);
+}
+
+// Память ограничена при сколь угодно длинной истории
+TEST(TieredBufferTest, BoundedHistory) {
+    TieredBuffer history(8);
+    history.add_tier(4, 4);
+    history.add_tier(4, 4);
+    for (int i = 0; i < 100000; i++) {
+        history.push_back(i % 1000);
+    }
+    EXPECT_EQ(history.size(0), 4);
+    EXPECT_EQ(history.size(1), 4);
+    EXPECT_EQ(history.at(1, 3).count, 16);
+    EXPECT_THROW(history.add_tier(2, 2), std::logic_error);
+    EXPECT_THROW(TieredBuffer(1).add_tier(0, 2), std::invalid_argument);
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "../Time_Series_Buffer.h"
+
+// Сэмплы старше окна удаляются при добавлении
+TEST(TimeSeriesBufferTest, EvictsByAge) {
+    TimeSeriesBuffer ts(10, 300);
+    ts.push_back(0, 1);
+    ts.push_back(100, 2);
+    ts.push_back(250, 3);
+    EXPECT_EQ(ts.size(), 3);
+
+    ts.push_back(350, 4); // окно [50, 350]
+    EXPECT_EQ(ts.size(), 3);
+    EXPECT_EQ(ts.front_time(), 100);
+    EXPECT_EQ(ts.value(0), 2);
+
+    ts.push_back(1000, 5);
+    EXPECT_EQ(ts.size(), 1);
+    EXPECT_EQ(ts.back_time(), 1000);
+
+    EXPECT_THROW(ts.push_back(999, 6), std::invalid_argument);
+}
+
+// Переполнение перезаписывает самые старые сэмплы
+TEST(TimeSeriesBufferTest, OverwritesWhenFull) {
+    TimeSeriesBuffer ts(3, 1000);
+    for (int i = 0; i < 5; ++i) {
+        ts.push_back(i * 10, i);
+    }
+    EXPECT_TRUE(ts.full());
+    EXPECT_EQ(ts.front_time(), 20);
+    EXPECT_EQ(ts.value(2), 4);
+}
+
+// Поиск диапазона через границу кольца возвращает два сегмента
+TEST(TimeSeriesBufferTest, RangeAcrossWrap) {
+    TimeSeriesBuffer ts(6, 1000);
+    for (int i = 0; i < 9; ++i) {
+        ts.push_back(i * 10, i * 100); // в буфере времена 30..80, голова в середине
+    }
+
+    TimeSeriesRange r = ts.range(45, 75);
+    ASSERT_EQ(r.size(), 3);
+    EXPECT_FALSE(r.values.second.empty());
+    std::vector<value_type> values;
+    for (value_type v : r.values.first) values.push_back(v);
+    for (value_type v : r.values.second) values.push_back(v);
+    EXPECT_EQ(values, (std::vector<value_type>{500, 600, 700}));
+    EXPECT_EQ(r.times.first[0], 50);
+
+    EXPECT_EQ(ts.range(30, 30).size(), 1);
+    EXPECT_EQ(ts.range(0, 20).size(), 0);
+    EXPECT_EQ(ts.range(85, 100).size(), 0);
+    EXPECT_EQ(ts.range(0, 1000).size(), 6);
+    EXPECT_EQ(ts.lower_bound(61), 4);
+}
+
+TEST(TimeSeriesBufferTest, EqualTimestampsAndWindowChange) {
+    TimeSeriesBuffer ts(8, 100);
+    ts.push_back(10, 1);
+    ts.push_back(10, 2);
+    ts.push_back(20, 3);
+    EXPECT_EQ(ts.range(10, 10).size(), 2);
+
+    ts.set_window(5);
+    EXPECT_EQ(ts.size(), 1);
+    EXPECT_EQ(ts.evict_older_than(100), 1);
+    EXPECT_TRUE(ts.empty());
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Task_Pool.h"
+#include "../Work_Stealing_Deque.h"
+
+// Владелец работает как со стеком, воры забирают старейшие элементы
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+    WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 100; i++) {
+        deque.push(i);
+    }
+    EXPECT_GE(deque.capacity(), 100);
+    EXPECT_EQ(deque.size(), 100);
+    EXPECT_EQ(*deque.pop(), 99);
+    EXPECT_EQ(*deque.steal(), 0);
+    EXPECT_EQ(*deque.steal(), 1);
+    EXPECT_EQ(*deque.pop(), 98);
+    while (deque.pop()) {
+    }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.steal().has_value());
+    EXPECT_THROW(WorkStealingDeque<int>(0), std::invalid_argument);
+}
+
+// Каждый элемент достаётся ровно одному потоку
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+    const int n = 200000;
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> taken(n);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; t++) {
+        thieves.emplace_back([&]() {
+            while (!done.load() || !deque.empty()) {
+                if (std::optional<int> item = deque.steal()) {
+                    taken[*item]++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < n; i++) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (std::optional<int> item = deque.pop()) {
+                taken[*item]++;
+            }
+        }
+    }
+    while (std::optional<int> item = deque.pop()) {
+        taken[*item]++;
+    }
+    done = true;
+    for (std::thread& t : thieves) {
+        t.join();
+    }
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(taken[i].load(), 1) << i;
+    }
+}
+
+static long long fib(TaskPool& pool, int n) {
+    if (n < 2) {
+        return n;
+    }
+    long long a = 0;
+    TaskGroup group(pool);
+    group.run([&pool, &a, n]() { a = fib(pool, n - 1); });
+    long long b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+// Пул выполняет задачи извне и вложенный fork-join
+TEST(TaskPoolTest, SubmitAndForkJoin) {
+    TaskPool pool(4);
+    EXPECT_EQ(pool.threads(), 4);
+    std::atomic<int> counter(0);
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&counter]() { counter++; });
+    }
+    pool.wait();
+    EXPECT_EQ(counter.load(), 1000);
+
+    long long result = 0;
+    pool.submit([&]() { result = fib(pool, 20); });
+    pool.wait();
+    EXPECT_EQ(result, 6765);
+
+    // Ожидание группы вне пула тоже помогает выполнять задачи
+    EXPECT_EQ(fib(pool, 15), 610);
+}
@@ -0,0 +1,110 @@
+#include"Tiered_Buffer.h"
+
+
+Aggregate Aggregate::of(const value_type& sample) {
+	Aggregate result;
+	result.min = sample;
+	result.max = sample;
+	result.sum = sample;
+	result.count = 1;
+	return result;
+}
+
+void Aggregate::merge(const Aggregate& other) {
+	if (count == 0) {
+		*this = other;
+		return;
+	}
+	if (other.min < min) min = other.min;
+	if (other.max > max) max = other.max;
+	sum += other.sum;
+	count += other.count;
+}
+
+double Aggregate::avg() const {
+	return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+TieredBuffer::TieredBuffer(int raw_capacity) : _raw(raw_capacity) {
+}
+
+void TieredBuffer::add_tier(int capacity, int factor) {
+	if (capacity <= 0 || factor <= 0) {
+		CB_THROW(std::invalid_argument("Tier capacity and factor must be positive"));
+	}
+	if (!_raw.empty()) {
+		CB_THROW(std::logic_error("Tiers must be added before the first push"));
+	}
+	Tier tier;
+	tier.ring.resize(capacity);
+	tier.head = 0;
+	tier.size = 0;
+	tier.factor = factor;
+	tier.pending = Aggregate();
+	tier.pending_entries = 0;
+	_tiers.push_back(tier);
+}
+
+void TieredBuffer::roll_up(int t, Aggregate evicted) {
+	// Each level fires once per factor evictions of the level below, so the
+	// cascade costs O(1) amortized per sample.
+	while (t < tiers()) {
+		Tier& tier = _tiers[t];
+		tier.pending.merge(evicted);
+		if (++tier.pending_entries < tier.factor) {
+			return;
+		}
+		Aggregate done = tier.pending;
+		tier.pending.count = 0;
+		tier.pending_entries = 0;
+
+		int capacity = static_cast<int>(tier.ring.size());
+		if (tier.size < capacity) {
+			int idx = tier.head + tier.size;
+			tier.ring[idx < capacity ? idx : idx - capacity] = done;
+			tier.size++;
+			return;
+		}
+		evicted = tier.ring[tier.head];
+		tier.ring[tier.head] = done;
+		tier.head = tier.head + 1 == capacity ? 0 : tier.head + 1;
+		t++;
+	}
+}
+
+void TieredBuffer::push_back(const value_type& item) {
+	if (_raw.full() && !_raw.empty()) {
+		roll_up(0, Aggregate::of(_raw.front()));
+	}
+	_raw.push_back(item);
+}
+
+const CircularBuffer& TieredBuffer::raw() const {
+	return _raw;
+}
+
+int TieredBuffer::tiers() const {
+	return static_cast<int>(_tiers.size());
+}
+
+int TieredBuffer::size(int tier) const {
+	if (tier < 0 || tier >= tiers()) {
+		CB_THROW(std::out_of_range("Tier does not exist"));
+	}
+	return _tiers[tier].size;
+}
+
+const Aggregate& TieredBuffer::at(int tier, int i) const {
+	if (tier < 0 || tier >= tiers() || i < 0 || i >= _tiers[tier].size) {
+		CB_THROW(std::out_of_range("Index out of range"));
+	}
+	const Tier& t = _tiers[tier];
+	return t.ring[(t.head + i) % t.ring.size()];
+}
+
+const Aggregate& TieredBuffer::pending(int tier) const {
+	if (tier < 0 || tier >= tiers()) {
+		CB_THROW(std::out_of_range("Tier does not exist"));
+	}
+	return _tiers[tier].pending;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Summary of a run of consecutive samples.
+ */
+struct Aggregate {
+	value_type min;		// Smallest sample
+	value_type max;		// Largest sample
+	long long sum;		// Sum of the samples
+	long long count;	// Number of samples
+
+	static Aggregate of(const value_type& sample);
+	void merge(const Aggregate& other);
+	double avg() const;
+};
+
+/**
+ * Multi-resolution history in the round-robin database style. Raw samples
+ * go to a CircularBuffer; every sample it evicts is rolled up into the first
+ * coarser tier, which stores one Aggregate (min/max/sum/count) per factor
+ * evicted entries, and so on up the tiers. Memory stays bounded while the
+ * covered time span grows with the product of the factors, and every push
+ * costs O(1) amortized.
+ */
+class TieredBuffer {
+	struct Tier {
+		std::vector<Aggregate> ring;	// Aggregates, oldest at head
+		int head;						// Index of the oldest aggregate
+		int size;						// Number of aggregates in the ring
+		int factor;						// Finer entries per aggregate
+		Aggregate pending;				// Aggregate being accumulated
+		int pending_entries;			// Finer entries merged into pending
+	};
+
+	CircularBuffer _raw;		// Finest tier with raw samples
+	std::vector<Tier> _tiers;	// Coarser tiers, finest first
+
+	void roll_up(int tier, Aggregate evicted);
+
+public:
+	/**
+     * Constructor to initialize a history without coarser tiers.
+     * @param raw_capacity Number of raw samples kept.
+     */
+	explicit TieredBuffer(int raw_capacity);
+
+	/**
+     * Add a coarser tier on top of the existing ones. Must be called before the first push.
+     * @param capacity Number of aggregates kept in the tier.
+     * @param factor Number of evicted entries of the finer tier per aggregate.
+     * @throws std::invalid_argument if capacity or factor is not positive.
+     * @throws std::logic_error if samples were already pushed.
+     */
+	void add_tier(int capacity, int factor);
+
+	/**
+     * Add a sample. When the raw buffer is full its oldest sample is rolled up.
+     * @param item The sample to add.
+     */
+	void push_back(const value_type& item);
+
+	/**
+     * Get the raw samples.
+     */
+	const CircularBuffer& raw() const;
+
+	/**
+     * Get the number of coarser tiers.
+     */
+	int tiers() const;
+
+	/**
+     * Get the number of complete aggregates in a tier.
+     * @param tier Index of the tier, 0 is the finest coarse tier.
+     * @throws std::out_of_range if the tier is invalid.
+     */
+	int size(int tier) const;
+
+	/**
+     * Access a complete aggregate of a tier.
+     * @param tier Index of the tier.
+     * @param i Index of the aggregate, 0 is the oldest.
+     * @throws std::out_of_range if the tier or the index is invalid.
+     */
+	const Aggregate& at(int tier, int i) const;
+
+	/**
+     * Get the aggregate still being accumulated in a tier; its count is 0 if nothing is pending.
+     * @throws std::out_of_range if the tier is invalid.
+     */
+	const Aggregate& pending(int tier) const;
+};
@@ -0,0 +1,165 @@
+#include<algorithm>
+#include<stdexcept>
+#include"Time_Series_Buffer.h"
+
+
+TimeSeriesBuffer::TimeSeriesBuffer(int capacity, timestamp_type window) {
+	if (capacity < 0) {
+		CB_THROW(std::invalid_argument("Capacity must be non-negative"));
+	}
+	if (window < 0) {
+		CB_THROW(std::invalid_argument("Window must be non-negative"));
+	}
+	_times.resize(capacity);
+	_values.resize(capacity);
+	_capacity = capacity;
+	_size = 0;
+	_idx_head = 0;
+	_window = window;
+}
+
+int TimeSeriesBuffer::physical(int i) const {
+	int idx = _idx_head + i;
+	return idx < _capacity ? idx : idx - _capacity;
+}
+
+int TimeSeriesBuffer::search(timestamp_type t, bool upper) const {
+	int first_len = std::min(_size, _capacity - _idx_head);
+	const timestamp_type* first = _times.data() + _idx_head;
+	const timestamp_type* second = _times.data();
+	int second_len = _size - first_len;
+
+	// Both segments are sorted and every timestamp of the first one is not
+	// greater than any of the second, so one comparison picks the segment.
+	bool in_second = second_len > 0 && (upper ? first[first_len - 1] <= t : first[first_len - 1] < t);
+	if (in_second) {
+		const timestamp_type* it = upper ? std::upper_bound(second, second + second_len, t)
+		                                 : std::lower_bound(second, second + second_len, t);
+		return first_len + static_cast<int>(it - second);
+	}
+	const timestamp_type* it = upper ? std::upper_bound(first, first + first_len, t)
+	                                 : std::lower_bound(first, first + first_len, t);
+	return static_cast<int>(it - first);
+}
+
+template <typename T>
+SegmentPair<const T> TimeSeriesBuffer::segments(const std::vector<T>& data, int first, int last) const {
+	int count = last - first;
+	int start = physical(first);
+	int first_len = std::min(count, _capacity - start);
+	SegmentPair<const T> result;
+	result.first.data = data.data() + start;
+	result.first.size = first_len;
+	result.second.data = data.data();
+	result.second.size = count - first_len;
+	return result;
+}
+
+void TimeSeriesBuffer::push_back(timestamp_type time, const value_type& value) {
+	if (!empty() && time < back_time()) {
+		CB_THROW(std::invalid_argument("Timestamps must be non-decreasing"));
+	}
+	if (_capacity == 0) {
+		return;
+	}
+	if (full()) {
+		pop_front();
+	}
+	int idx = physical(_size);
+	_times[idx] = time;
+	_values[idx] = value;
+	_size++;
+	evict_older_than(time - _window);
+}
+
+void TimeSeriesBuffer::pop_front() {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	_idx_head = physical(1);
+	_size--;
+}
+
+int TimeSeriesBuffer::evict_older_than(timestamp_type time) {
+	int count = lower_bound(time);
+	_idx_head = _capacity == 0 ? 0 : (_idx_head + count) % _capacity;
+	_size -= count;
+	return count;
+}
+
+timestamp_type TimeSeriesBuffer::time(int i) const {
+	return _times[physical(i)];
+}
+
+const value_type& TimeSeriesBuffer::value(int i) const {
+	return _values[physical(i)];
+}
+
+timestamp_type TimeSeriesBuffer::front_time() const {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _times[_idx_head];
+}
+
+timestamp_type TimeSeriesBuffer::back_time() const {
+	if (empty()) {
+		CB_THROW(std::out_of_range("Buffer is empty"));
+	}
+	return _times[physical(_size - 1)];
+}
+
+int TimeSeriesBuffer::lower_bound(timestamp_type time) const {
+	return search(time, false);
+}
+
+TimeSeriesRange TimeSeriesBuffer::range(timestamp_type from, timestamp_type to) const {
+	int first = search(from, false);
+	int last = std::max(first, search(to, true));
+	TimeSeriesRange result;
+	result.times = segments(_times, first, last);
+	result.values = segments(_values, first, last);
+	return result;
+}
+
+TimeSeriesRange TimeSeriesBuffer::all() const {
+	TimeSeriesRange result;
+	result.times = segments(_times, 0, _size);
+	result.values = segments(_values, 0, _size);
+	return result;
+}
+
+int TimeSeriesBuffer::size() const {
+	return _size;
+}
+
+bool TimeSeriesBuffer::empty() const {
+	return _size == 0;
+}
+
+bool TimeSeriesBuffer::full() const {
+	return _size == _capacity;
+}
+
+int TimeSeriesBuffer::capacity() const {
+	return _capacity;
+}
+
+timestamp_type TimeSeriesBuffer::window() const {
+	return _window;
+}
+
+void TimeSeriesBuffer::set_window(timestamp_type window) {
+	if (window < 0) {
+		CB_THROW(std::invalid_argument("Window must be non-negative"));
+	}
+	_window = window;
+	if (!empty()) {
+		evict_older_than(back_time() - _window);
+	}
+}
+
+void TimeSeriesBuffer::clear() {
+	_size = 0;
+	_idx_head = 0;
+}
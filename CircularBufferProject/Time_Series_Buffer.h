@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Circular_Buffer.h"
+
+typedef std::int64_t timestamp_type;
+
+/**
+ * Samples of a TimeSeriesBuffer falling into a time range, as zero-copy
+ * views. times and values cover the same logical positions.
+ */
+struct TimeSeriesRange {
+	SegmentPair<const timestamp_type> times;
+	SegmentPair<const value_type> values;
+
+	size_type size() const { return times.size(); }
+	bool empty() const { return times.empty(); }
+};
+
+/**
+ * Ring of (timestamp, value) samples with non-decreasing timestamps.
+ * Samples older than the configured window are evicted on push, and time
+ * ranges are located by binary search over the two monotonic segments.
+ * Timestamps and values are kept in separate arrays so that scanning
+ * values does not pull timestamps through the cache.
+ */
+class TimeSeriesBuffer {
+	std::vector<timestamp_type> _times;	// Timestamps, parallel to _values
+	std::vector<value_type> _values;	// Sample values
+	int _capacity;						// Total capacity of the buffer
+	int _size;							// Current number of samples in the buffer
+	int _idx_head;						// Index of the oldest sample
+	timestamp_type _window;				// Maximum age of a sample relative to the newest one
+
+	int physical(int i) const;
+	int search(timestamp_type t, bool upper) const;
+	template <typename T>
+	SegmentPair<const T> segments(const std::vector<T>& data, int first, int last) const;
+
+public:
+	/**
+     * Constructor to initialize a buffer with a capacity and a time window.
+     * @param capacity The maximum number of samples the buffer can hold.
+     * @param window Samples older than newest timestamp - window are evicted.
+     * @throws std::invalid_argument if capacity or window is negative.
+     */
+	TimeSeriesBuffer(int capacity, timestamp_type window);
+
+	/**
+     * Add a sample to the end of the buffer and evict samples that fell out
+     * of the time window. If the buffer is full, the oldest sample is overwritten.
+     * @param time Timestamp of the sample, not less than back_time().
+     * @param value The sample value.
+     * @throws std::invalid_argument if the timestamp goes backwards.
+     */
+	void push_back(timestamp_type time, const value_type& value);
+
+	/**
+     * Remove the oldest sample from the buffer.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	void pop_front();
+
+	/**
+     * Remove all samples with a timestamp strictly less than the given one.
+     * @param time The oldest timestamp to keep.
+     * @return Number of removed samples.
+     */
+	int evict_older_than(timestamp_type time);
+
+	/**
+     * Access the timestamp and the value of a sample by index without bounds checking.
+     * @param i Index of the sample, 0 is the oldest.
+     */
+	timestamp_type time(int i) const;
+	const value_type& value(int i) const;
+
+	/**
+     * Get the timestamp of the oldest / newest sample.
+     * @throws std::out_of_range if the buffer is empty.
+     */
+	timestamp_type front_time() const;
+	timestamp_type back_time() const;
+
+	/**
+     * Find the index of the first sample with timestamp not less than the given one.
+     * Runs in O(log n).
+     * @param time The timestamp to look for.
+     * @return Index of the sample, size() if there is none.
+     */
+	int lower_bound(timestamp_type time) const;
+
+	/**
+     * Get all samples with timestamps in [from, to]. Runs in O(log n).
+     * @param from The first timestamp of the range (inclusive).
+     * @param to The last timestamp of the range (inclusive).
+     * @return Views over the timestamps and values, valid until the next modification.
+     */
+	TimeSeriesRange range(timestamp_type from, timestamp_type to) const;
+
+	/**
+     * Get views over all samples currently in the buffer.
+     */
+	TimeSeriesRange all() const;
+
+	int size() const;
+	bool empty() const;
+	bool full() const;
+	int capacity() const;
+	timestamp_type window() const;
+
+	/**
+     * Change the time window. Samples outside the new window are evicted.
+     * @param window The new maximum age of a sample.
+     * @throws std::invalid_argument if the window is negative.
+     */
+	void set_window(timestamp_type window);
+
+	/**
+     * Clear the buffer, removing all samples.
+     */
+	void clear();
+};
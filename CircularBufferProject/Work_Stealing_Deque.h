@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "Circular_Buffer.h"
+
+/**
+ * Lock-free Chase-Lev work-stealing deque. The owner thread pushes and pops
+ * at the bottom like a stack; any number of thief threads steal from the top
+ * in FIFO order. Only the last element is contended, and the owner pays a
+ * CAS just for that one. The ring grows by doubling when the owner finds it
+ * full; the old array may still be read by a thief that loaded it earlier,
+ * so retired arrays are kept until the deque is destroyed (their total size
+ * is less than the live one). Elements are copied through std::atomic<T>,
+ * so T must be trivially copyable; store pointers or indices for larger tasks.
+ * Memory orderings follow Le, Pop, Cohen, Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), except that
+ * the release fence in push() is folded into a release store of the bottom.
+ */
+template <typename T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque elements must be trivially copyable");
+
+	struct Array {
+		size_type capacity;						// Power of two
+		std::unique_ptr<std::atomic<T>[]> slots;	// Ring storage
+
+		explicit Array(size_type n) : capacity(n), slots(new std::atomic<T>[n]) {}
+
+		T get(std::int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+		void put(std::int64_t i, T item) { slots[i & (capacity - 1)].store(item, std::memory_order_relaxed); }
+	};
+
+	alignas(64) std::atomic<std::int64_t> _top;		// Next index to steal, only grows
+	alignas(64) std::atomic<std::int64_t> _bottom;	// Next index to push, owned by the owner thread
+	std::atomic<Array*> _array;						// Current ring
+	std::vector<std::unique_ptr<Array>> _arrays;	// Current and retired rings, owner only
+
+	Array* grow(Array* old, std::int64_t top, std::int64_t bottom) {
+		std::unique_ptr<Array> bigger(new Array(old->capacity * 2));
+		for (std::int64_t i = top; i < bottom; i++) {
+			bigger->put(i, old->get(i));
+		}
+		Array* result = bigger.get();
+		_arrays.push_back(std::move(bigger));
+		_array.store(result, std::memory_order_release);
+		return result;
+	}
+
+public:
+	/**
+     * Constructor to initialize an empty deque.
+     * @param capacity Initial capacity, rounded up to a power of two.
+     * @throws std::invalid_argument if the capacity is not positive.
+     */
+	explicit WorkStealingDeque(size_type capacity = 64) : _top(0), _bottom(0) {
+		if (capacity <= 0) {
+			CB_THROW(std::invalid_argument("Capacity must be positive"));
+		}
+		size_type n = 1;
+		while (n < capacity) {
+			n *= 2;
+		}
+		_arrays.emplace_back(new Array(n));
+		_array.store(_arrays.back().get(), std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/**
+     * Add an element at the bottom. Owner thread only; grows the ring when full.
+     */
+	void push(T item) {
+		std::int64_t b = _bottom.load(std::memory_order_relaxed);
+		std::int64_t t = _top.load(std::memory_order_acquire);
+		Array* a = _array.load(std::memory_order_relaxed);
+		if (b - t > a->capacity - 1) {
+			a = grow(a, t, b);
+		}
+		a->put(b, item);
+		_bottom.store(b + 1, std::memory_order_release);
+	}
+
+	/**
+     * Remove the element at the bottom, the one pushed last. Owner thread only.
+     * @return The element, or std::nullopt if the deque is empty or a thief took the last one.
+     */
+	std::optional<T> pop() {
+		std::int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+		Array* a = _array.load(std::memory_order_relaxed);
+		_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t t = _top.load(std::memory_order_relaxed);
+		if (t > b) {
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+		T item = a->get(b);
+		if (t == b) {
+			// Last element: race the thieves for it.
+			bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			if (!won) {
+				return std::nullopt;
+			}
+		}
+		return item;
+	}
+
+	/**
+     * Remove the element at the top, the oldest one. Safe from any thread.
+     * @return The element, or std::nullopt if the deque is empty or another thread won the race.
+     */
+	std::optional<T> steal() {
+		std::int64_t t = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t b = _bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			return std::nullopt;
+		}
+		Array* a = _array.load(std::memory_order_acquire);
+		T item = a->get(t);
+		if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return std::nullopt;
+		}
+		return item;
+	}
+
+	/**
+     * Get the number of elements. Exact for the owner when no steal is in flight,
+     * a snapshot otherwise.
+     */
+	size_type size() const {
+		std::int64_t b = _bottom.load(std::memory_order_relaxed);
+		std::int64_t t = _top.load(std::memory_order_relaxed);
+		return b > t ? static_cast<size_type>(b - t) : 0;
+	}
+
+	bool empty() const { return size() == 0; }
+
+	/**
+     * Get the capacity of the current ring.
+     */
+	size_type capacity() const { return _array.load(std::memory_order_relaxed)->capacity; }
+};